@@ -0,0 +1,60 @@
+#ifndef S21_BENCHMARK_GRAPHS_H_
+#define S21_BENCHMARK_GRAPHS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+inline double Milliseconds(BenchmarkClock::time_point begin) {
+  return std::chrono::duration<double, std::milli>(BenchmarkClock::now() -
+                                                   begin)
+      .count();
+}
+
+/* side x side grid edge list with random weights, the shape of a road
+ * network */
+inline bool WriteGrid(const std::string& filename, int side) {
+  std::mt19937 random(21);
+  std::uniform_int_distribution<int> weight(1, 100);
+  std::ofstream file(filename);
+  file << side * side << '\n';
+  for (int row = 0; row < side; ++row) {
+    for (int col = 0; col < side; ++col) {
+      const int v = row * side + col + 1;
+      if (col + 1 < side) {
+        file << v << ' ' << v + 1 << ' ' << weight(random) << '\n';
+      }
+      if (row + 1 < side) {
+        file << v << ' ' << v + side << ' ' << weight(random) << '\n';
+      }
+    }
+  }
+  return file.good();
+}
+
+/* edge list with the given number of random edges, without self loops or
+ * repeated pairs; a spanning path keeps it connected */
+inline bool WriteRandomGraph(const std::string& filename, int vertices,
+                             int edges) {
+  std::mt19937 random(21);
+  std::uniform_int_distribution<int> vertex(1, vertices);
+  std::set<std::pair<int, int>> pairs;
+  for (int v = 1; v < vertices; ++v) pairs.insert({v, v + 1});
+  while (static_cast<int>(pairs.size()) < edges) {
+    const int a = vertex(random);
+    const int b = vertex(random);
+    if (a != b) pairs.insert({std::min(a, b), std::max(a, b)});
+  }
+  std::ofstream file(filename);
+  file << vertices << '\n';
+  for (const auto& [a, b] : pairs) file << a << ' ' << b << " 1\n";
+  return file.good();
+}
+
+#endif  // S21_BENCHMARK_GRAPHS_H_
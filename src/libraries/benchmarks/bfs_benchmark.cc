@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "benchmark_graphs.h"
+#include "graph.h"
+#include "graph_algorithms.h"
+#include "parallel.h"
+
+/* usage: bfs_benchmark [vertices] [edges] [max threads] */
+int main(int argc, char** argv) {
+  const int vertices = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const int edges = argc > 2 ? std::atoi(argv[2]) : 500000;
+  const int max_threads =
+      argc > 3 ? std::atoi(argv[3]) : static_cast<int>(HardwareThreads());
+  const std::string filename = "libraries/tests/output/benchmark_random.txt";
+
+  Graph graph;
+  if (vertices < 2 || edges < vertices - 1 || max_threads < 1 ||
+      !WriteRandomGraph(filename, vertices, edges) ||
+      !graph.LoadGraphFromEdgeList(filename)) {
+    std::fprintf(stderr, "cannot prepare a random graph with %d vertices\n",
+                 vertices);
+    return 1;
+  }
+  std::printf("vertices %zu, edges %zu\n", graph.Size(),
+              graph.EdgeCount() / 2);
+
+  constexpr int kRuns = 10;
+  const auto measure = [&](const char* name, const auto& run) {
+    run();
+    const auto begin = BenchmarkClock::now();
+    for (int i = 0; i < kRuns; ++i) run();
+    std::printf("%s: %.2f ms\n", name, Milliseconds(begin) / kRuns);
+  };
+
+  std::vector<int> top_down;
+  std::vector<int> optimizing;
+  measure("ordered, top-down", [&] {
+    top_down = GraphAlgorithms::BreadthFirstSearch(graph, 1);
+  });
+  measure("ordered, direction-optimizing", [&] {
+    optimizing = GraphAlgorithms::BreadthFirstSearch(
+        graph, 1, BfsMode::kDirectionOptimizing);
+  });
+  if (optimizing != top_down) {
+    std::fprintf(stderr, "visit orders differ\n");
+    return 1;
+  }
+  measure("hop distances", [&] { GraphAlgorithms::GetHopDistances(graph, 1); });
+
+  /* thread counts double up to the limit, which is always measured */
+  for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+    const std::string name =
+        "level-synchronous tree, " + std::to_string(threads) + " threads";
+    measure(name.c_str(), [&] {
+      GraphAlgorithms::GetBfsTree(graph, 1, static_cast<unsigned>(threads));
+    });
+    if (threads == max_threads) break;
+  }
+  return 0;
+}
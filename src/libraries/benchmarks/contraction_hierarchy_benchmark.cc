@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark_graphs.h"
+#include "contraction_hierarchy.h"
+#include "graph.h"
+#include "graph_algorithms.h"
+
+/* usage: contraction_hierarchy_benchmark [grid side] [queries] */
+int main(int argc, char** argv) {
+  const int side = argc > 1 ? std::atoi(argv[1]) : 100;
+  const int queries = argc > 2 ? std::atoi(argv[2]) : 200;
+  const std::string filename = "libraries/tests/output/benchmark_grid.txt";
+
+  Graph graph;
+  if (side < 2 || queries < 1 || !WriteGrid(filename, side) ||
+      !graph.LoadGraphFromEdgeList(filename)) {
+    std::fprintf(stderr, "cannot prepare a %d x %d grid\n", side, side);
+    return 1;
+  }
+
+  auto begin = BenchmarkClock::now();
+  ContractionHierarchy hierarchy;
+  hierarchy.Build(graph);
+  std::printf("vertices %zu, shortcuts %zu, preprocessing %.1f ms\n",
+              graph.Size(), hierarchy.ShortcutCount(), Milliseconds(begin));
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> vertex(1, static_cast<int>(graph.Size()));
+  std::vector<std::pair<int, int>> pairs(queries);
+  for (auto& pair : pairs) pair = {vertex(random), vertex(random)};
+
+  long long checksum = 0;
+  begin = BenchmarkClock::now();
+  for (const auto& [from, to] : pairs) {
+    checksum +=
+        GraphAlgorithms::GetShortestPathBetweenVertices(graph, from, to);
+  }
+  const double dijkstra = Milliseconds(begin);
+
+  begin = BenchmarkClock::now();
+  for (const auto& [from, to] : pairs) {
+    checksum -= hierarchy.GetShortestPathBetweenVertices(from, to);
+  }
+  const double contracted = Milliseconds(begin);
+
+  std::printf(
+      "dijkstra %.3f ms/query, hierarchy %.3f ms/query, speedup %.1fx\n",
+      dijkstra / queries, contracted / queries, dijkstra / contracted);
+  if (checksum != 0) {
+    std::fprintf(stderr, "distances differ\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "benchmark_graphs.h"
+#include "graph.h"
+#include "graph_algorithms.h"
+#include "parallel.h"
+
+/* usage: spanning_tree_benchmark [grid side] [max threads] */
+int main(int argc, char** argv) {
+  const int side = argc > 1 ? std::atoi(argv[1]) : 500;
+  const int max_threads =
+      argc > 2 ? std::atoi(argv[2]) : static_cast<int>(HardwareThreads());
+  const std::string filename = "libraries/tests/output/benchmark_grid.txt";
+
+  Graph graph;
+  if (side < 2 || max_threads < 1 || !WriteGrid(filename, side) ||
+      !graph.LoadGraphFromEdgeList(filename)) {
+    std::fprintf(stderr, "cannot prepare a %d x %d grid\n", side, side);
+    return 1;
+  }
+  std::printf("vertices %zu, edges %zu\n", graph.Size(),
+              graph.EdgeCount() / 2);
+
+  auto begin = BenchmarkClock::now();
+  const auto kruskal = GraphAlgorithms::GetMinimumSpanningTree(
+      graph, 1, SpanningTreeMode::kKruskal);
+  std::printf("kruskal, 1 thread: %.1f ms\n", Milliseconds(begin));
+
+  /* thread counts double up to the limit, which is always measured */
+  for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+    begin = BenchmarkClock::now();
+    const auto boruvka = GraphAlgorithms::GetMinimumSpanningTree(
+        graph, threads, SpanningTreeMode::kBoruvka);
+    std::printf("boruvka, %d threads: %.1f ms\n", threads,
+                Milliseconds(begin));
+    if (boruvka.total_weight != kruskal.total_weight) {
+      std::fprintf(stderr, "total weights differ\n");
+      return 1;
+    }
+    if (threads == max_threads) break;
+  }
+  return 0;
+}
@@ -0,0 +1,58 @@
+#ifndef S21_BITSET_H_
+#define S21_BITSET_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* fixed size set of vertices packed into 64-bit words, visiting the set or
+ * the clear bits skips a whole word per test */
+class Bitset {
+ public:
+  Bitset() = default;
+  explicit Bitset(size_t size) : size_(size), words_((size + 63) / 64, 0) {}
+
+  size_t size() const { return size_; }
+
+  bool Test(size_t i) const { return (words_[i / 64] >> (i % 64)) & 1; }
+  void Set(size_t i) { words_[i / 64] |= uint64_t{1} << (i % 64); }
+  void Clear() { std::fill(words_.begin(), words_.end(), 0); }
+
+  size_t Count() const {
+    size_t count = 0;
+    for (uint64_t word : words_) count += std::popcount(word);
+    return count;
+  }
+
+  /* function(i) for every set bit in increasing order */
+  template <typename Function>
+  void ForEachSet(Function function) const {
+    for (size_t w = 0; w < words_.size(); ++w) {
+      for (uint64_t word = words_[w]; word != 0; word &= word - 1) {
+        function(w * 64 + std::countr_zero(word));
+      }
+    }
+  }
+
+  /* function(i) for every clear bit below size() in increasing order */
+  template <typename Function>
+  void ForEachClear(Function function) const {
+    for (size_t w = 0; w < words_.size(); ++w) {
+      uint64_t word = ~words_[w];
+      if (w + 1 == words_.size() && size_ % 64 != 0) {
+        word &= (uint64_t{1} << (size_ % 64)) - 1;
+      }
+      for (; word != 0; word &= word - 1) {
+        function(w * 64 + std::countr_zero(word));
+      }
+    }
+  }
+
+ private:
+  size_t size_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+#endif  // S21_BITSET_H_
@@ -0,0 +1,108 @@
+#ifndef S21_BUFFER_H_
+#define S21_BUFFER_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+/* allocator handing out storage aligned to a cache line */
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(
+        ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+  void deallocate(T* p, size_t) {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const {
+    return true;
+  }
+};
+
+/* contiguous array that either owns its elements or borrows them from memory
+ * kept alive by a shared owner (e.g. a mapped snapshot file), the first
+ * write through a mutable accessor detaches a borrowed buffer into a copy */
+template <typename T>
+class Buffer {
+ public:
+  static constexpr size_t kAlignment = 64;
+
+  Buffer() = default;
+  explicit Buffer(size_t size, const T& value = T())
+      : owned_(size, value), data_(owned_.data()), size_(size) {}
+  Buffer(std::shared_ptr<const void> owner, const T* data, size_t size)
+      : owner_(std::move(owner)), data_(data), size_(size) {}
+
+  Buffer(const Buffer& other)
+      : owned_(other.owned_),
+        owner_(other.owner_),
+        data_(other.owner_ ? other.data_ : owned_.data()),
+        size_(other.size_) {}
+  Buffer(Buffer&& other) noexcept { Swap(other); }
+  Buffer& operator=(Buffer other) noexcept {
+    Swap(other);
+    return *this;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool IsBorrowed() const { return owner_ != nullptr; }
+
+  const T* data() const { return data_; }
+  T* data() {
+    Detach();
+    return owned_.data();
+  }
+
+  const T& operator[](size_t i) const { return data_[i]; }
+  T& operator[](size_t i) { return data()[i]; }
+
+  std::span<const T> Span() const { return std::span<const T>(data_, size_); }
+
+  /* detaches a borrowed buffer, new elements are value initialized */
+  void resize(size_t size) {
+    Detach();
+    owned_.resize(size);
+    data_ = owned_.data();
+    size_ = size;
+  }
+
+ private:
+  void Swap(Buffer& other) noexcept {
+    owned_.swap(other.owned_);
+    owner_.swap(other.owner_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+  }
+
+  void Detach() {
+    if (owner_ == nullptr) return;
+    owned_.assign(data_, data_ + size_);
+    owner_.reset();
+    data_ = owned_.data();
+  }
+
+  std::vector<T, AlignedAllocator<T, kAlignment>> owned_;
+  std::shared_ptr<const void> owner_;
+  const T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+#endif  // S21_BUFFER_H_
@@ -0,0 +1,424 @@
+#include "contraction_hierarchy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'C', 'H', 'I', 'E', 'R'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+/* a witness search gives up after this many settled vertices and keeps the
+ * shortcut, which costs space but never correctness */
+constexpr size_t kWitnessSettleLimit = 128;
+
+struct HierarchyHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t distance_size;
+  uint32_t reserved;
+  uint64_t vertices;
+  uint64_t arcs;
+  uint64_t shortcuts;
+};
+
+static_assert(std::is_trivially_copyable_v<HierarchyHeader>);
+
+/* the shrinking graph of vertices that are not contracted yet */
+template <typename Weight>
+class Contraction {
+ public:
+  using Distance = typename WeightTraits<Weight>::Distance;
+  struct Arc {
+    int to;
+    Distance weight;
+  };
+
+  explicit Contraction(const BasicGraph<Weight>& graph)
+      : arcs_(graph.Size()),
+        contracted_neighbors_(graph.Size(), 0),
+        witness_(graph.Size(), WeightTraits<Weight>::kInfinity) {
+    for (size_t v = 0; v < graph.Size(); ++v) {
+      const auto neighbors = graph.Neighbors(v);
+      const auto weights = graph.NeighborWeights(v);
+      for (size_t e = 0; e < neighbors.size(); ++e) {
+        if (static_cast<size_t>(neighbors[e]) != v) {
+          arcs_[v].push_back({neighbors[e], weights[e]});
+        }
+      }
+    }
+  }
+
+  /* edge difference: shortcuts the contraction would add minus the edges it
+   * removes, contracted neighbors spread the contraction over the graph */
+  long long Priority(int vertex) {
+    long long shortcuts = 0;
+    FindShortcuts(vertex, [&shortcuts](int, int, Distance) { ++shortcuts; });
+    return shortcuts - static_cast<long long>(arcs_[vertex].size()) +
+           contracted_neighbors_[vertex];
+  }
+
+  /* removes the vertex and returns its arcs, all of them go to vertices
+   * contracted later */
+  std::vector<Arc> Contract(int vertex, size_t* shortcuts) {
+    struct Shortcut {
+      int from;
+      int to;
+      Distance weight;
+    };
+    std::vector<Shortcut> added;
+    FindShortcuts(vertex, [&added](int from, int to, Distance weight) {
+      added.push_back({from, to, weight});
+    });
+    for (const auto& shortcut : added) {
+      if (AddArc(shortcut.from, shortcut.to, shortcut.weight)) ++*shortcuts;
+    }
+
+    std::vector<Arc> upward = std::move(arcs_[vertex]);
+    arcs_[vertex].clear();
+    for (const Arc& arc : upward) {
+      auto& arcs = arcs_[arc.to];
+      arcs.erase(std::find_if(arcs.begin(), arcs.end(), [vertex](const Arc& a) {
+        return a.to == vertex;
+      }));
+      ++contracted_neighbors_[arc.to];
+    }
+    return upward;
+  }
+
+ private:
+  using Entry = std::pair<Distance, int>;
+
+  /* calls found(u, w, weight) for every pair of neighbors whose shortest
+   * path may run through the vertex */
+  template <typename Found>
+  void FindShortcuts(int vertex, Found found) {
+    const auto& arcs = arcs_[vertex];
+    Distance longest = 0;
+    for (const Arc& arc : arcs) longest = std::max(longest, arc.weight);
+
+    for (size_t i = 0; i + 1 < arcs.size(); ++i) {
+      Witness(arcs[i].to, vertex, arcs[i].weight + longest);
+      for (size_t j = i + 1; j < arcs.size(); ++j) {
+        const Distance via = arcs[i].weight + arcs[j].weight;
+        if (witness_[arcs[j].to] > via) found(arcs[i].to, arcs[j].to, via);
+      }
+      for (int v : touched_) witness_[v] = WeightTraits<Weight>::kInfinity;
+      touched_.clear();
+    }
+  }
+
+  /* bounded Dijkstra from source that avoids the excluded vertex */
+  void Witness(int source, int excluded, Distance limit) {
+    witness_[source] = 0;
+    touched_.push_back(source);
+    heap_.assign(1, {0, source});
+
+    size_t settled = 0;
+    while (!heap_.empty() && settled < kWitnessSettleLimit) {
+      std::pop_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+      const auto [distance, v] = heap_.back();
+      heap_.pop_back();
+      if (distance > limit) break;
+      if (distance != witness_[v]) continue;
+      ++settled;
+
+      for (const Arc& arc : arcs_[v]) {
+        const Distance candidate = distance + arc.weight;
+        if (arc.to == excluded || candidate >= witness_[arc.to]) continue;
+        if (witness_[arc.to] == WeightTraits<Weight>::kInfinity) {
+          touched_.push_back(arc.to);
+        }
+        witness_[arc.to] = candidate;
+        heap_.push_back({candidate, arc.to});
+        std::push_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+      }
+    }
+  }
+
+  /* true when the edge is new rather than a shorter weight for one */
+  bool AddArc(int from, int to, Distance weight) {
+    auto& arcs = arcs_[from];
+    auto it = std::find_if(arcs.begin(), arcs.end(),
+                           [to](const Arc& arc) { return arc.to == to; });
+    if (it != arcs.end()) {
+      if (weight < it->weight) {
+        it->weight = weight;
+        std::find_if(arcs_[to].begin(), arcs_[to].end(),
+                     [from](const Arc& arc) { return arc.to == from; })
+            ->weight = weight;
+      }
+      return false;
+    }
+    arcs.push_back({to, weight});
+    arcs_[to].push_back({from, weight});
+    return true;
+  }
+
+  std::vector<std::vector<Arc>> arcs_;
+  std::vector<int> contracted_neighbors_;
+  std::vector<Distance> witness_;
+  std::vector<int> touched_;
+  std::vector<Entry> heap_;
+};
+
+}  // namespace
+
+template <typename Weight>
+bool BasicContractionHierarchy<Weight>::Build(const GraphType& graph) {
+  const size_t size = graph.Size();
+  if (size == 0) return false;
+
+  Contraction<Weight> contraction(graph);
+  using Priority = std::pair<long long, int>;
+  std::priority_queue<Priority, std::vector<Priority>, std::greater<Priority>>
+      queue;
+  for (size_t v = 0; v < size; ++v) {
+    const int vertex = static_cast<int>(v);
+    queue.push({contraction.Priority(vertex), vertex});
+  }
+
+  std::vector<int> rank(size);
+  std::vector<std::vector<typename Contraction<Weight>::Arc>> upward(size);
+  size_t shortcuts = 0;
+  int next_rank = 0;
+  while (!queue.empty()) {
+    const int v = queue.top().second;
+    queue.pop();
+    /* priorities go stale as neighbors are contracted, a vertex that is no
+     * longer the cheapest goes back into the queue */
+    const long long priority = contraction.Priority(v);
+    if (!queue.empty() && priority > queue.top().first) {
+      queue.push({priority, v});
+      continue;
+    }
+    rank[v] = next_rank++;
+    upward[v] = contraction.Contract(v, &shortcuts);
+  }
+
+  up_offsets_.assign(size + 1, 0);
+  for (size_t v = 0; v < size; ++v) {
+    up_offsets_[v + 1] = up_offsets_[v] + upward[v].size();
+  }
+  up_targets_.resize(up_offsets_[size]);
+  up_weights_.resize(up_offsets_[size]);
+  for (size_t v = 0; v < size; ++v) {
+    size_t e = up_offsets_[v];
+    for (const auto& arc : upward[v]) {
+      up_targets_[e] = arc.to;
+      up_weights_[e++] = arc.weight;
+    }
+  }
+  rank_ = std::move(rank);
+  shortcuts_ = shortcuts;
+  return true;
+}
+
+template <typename Weight>
+bool BasicContractionHierarchy<Weight>::SaveBinary(
+    const std::string& filename) const {
+  const size_t size = Size();
+  if (size == 0) return false;
+
+  HierarchyHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrderMark;
+  header.distance_size = sizeof(Distance);
+  header.vertices = size;
+  header.arcs = up_targets_.size();
+  header.shortcuts = shortcuts_;
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) return false;
+  const auto write = [&file](const void* data, size_t bytes) {
+    file.write(static_cast<const char*>(data),
+               static_cast<std::streamsize>(bytes));
+  };
+  write(&header, sizeof(header));
+  write(rank_.data(), size * sizeof(int));
+  write(up_offsets_.data(), (size + 1) * sizeof(size_t));
+  write(up_targets_.data(), header.arcs * sizeof(int));
+  write(up_weights_.data(), header.arcs * sizeof(Distance));
+  return file.good();
+}
+
+template <typename Weight>
+bool BasicContractionHierarchy<Weight>::LoadBinary(
+    const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) return false;
+  const uint64_t file_size = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+
+  HierarchyHeader header{};
+  if (file_size < sizeof(header) ||
+      !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.byte_order != kByteOrderMark ||
+      header.distance_size != sizeof(Distance) || header.vertices == 0 ||
+      header.vertices >= file_size || header.arcs >= file_size ||
+      header.shortcuts > header.arcs) {
+    return false;
+  }
+  const uint64_t expected =
+      sizeof(header) + header.vertices * sizeof(int) +
+      (header.vertices + 1) * sizeof(size_t) +
+      header.arcs * (sizeof(int) + sizeof(Distance));
+  if (expected != file_size) return false;
+
+  const size_t size = header.vertices;
+  std::vector<int> rank(size);
+  std::vector<size_t> offsets(size + 1);
+  std::vector<int> targets(header.arcs);
+  std::vector<Distance> weights(header.arcs);
+  const auto read = [&file](void* data, size_t bytes) {
+    return static_cast<bool>(file.read(static_cast<char*>(data),
+                                       static_cast<std::streamsize>(bytes)));
+  };
+  if (!read(rank.data(), size * sizeof(int)) ||
+      !read(offsets.data(), (size + 1) * sizeof(size_t)) ||
+      !read(targets.data(), header.arcs * sizeof(int)) ||
+      !read(weights.data(), header.arcs * sizeof(Distance))) {
+    return false;
+  }
+
+  /* ranks must be a permutation and every arc must go upward */
+  std::vector<char> seen(size, 0);
+  for (int r : rank) {
+    if (r < 0 || static_cast<size_t>(r) >= size || seen[r]) return false;
+    seen[r] = 1;
+  }
+  /* non-decreasing offsets ending at the arc count keep every row in
+   * bounds, so they are all checked before any arc is read */
+  if (offsets[0] != 0 || offsets[size] != header.arcs) return false;
+  for (size_t v = 0; v < size; ++v) {
+    if (offsets[v] > offsets[v + 1]) return false;
+  }
+  for (size_t v = 0; v < size; ++v) {
+    for (size_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+      if (targets[e] < 0 || static_cast<size_t>(targets[e]) >= size ||
+          rank[targets[e]] <= rank[v] || weights[e] < 0 ||
+          weights[e] >= WeightTraits<Weight>::kInfinity) {
+        return false;
+      }
+    }
+  }
+
+  rank_ = std::move(rank);
+  up_offsets_ = std::move(offsets);
+  up_targets_ = std::move(targets);
+  up_weights_ = std::move(weights);
+  shortcuts_ = header.shortcuts;
+  return true;
+}
+
+template <typename Weight>
+int BasicContractionHierarchy<Weight>::GetShortestPathBetweenVertices(
+    int vertex1, int vertex2) const {
+  thread_local Workspace workspace;
+  return GetShortestPathBetweenVertices(vertex1, vertex2, workspace);
+}
+
+template <typename Weight>
+int BasicContractionHierarchy<Weight>::GetShortestPathBetweenVertices(
+    int vertex1, int vertex2, Workspace& workspace) const {
+  const size_t size = Size();
+  if (size == 0 || vertex1 < 1 || vertex2 < 1 ||
+      static_cast<size_t>(vertex1) > size ||
+      static_cast<size_t>(vertex2) > size) {
+    return -1;
+  }
+
+  const Distance distance = Search(vertex1 - 1, vertex2 - 1, workspace);
+  if (distance == WeightTraits<Weight>::kInfinity ||
+      std::cmp_greater(distance, std::numeric_limits<int>::max())) {
+    return -1;
+  }
+  return static_cast<int>(distance);
+}
+
+template <typename Weight>
+size_t BasicContractionHierarchy<Weight>::Size() const {
+  return rank_.size();
+}
+
+template <typename Weight>
+size_t BasicContractionHierarchy<Weight>::ShortcutCount() const {
+  return shortcuts_;
+}
+
+template <typename Weight>
+typename BasicContractionHierarchy<Weight>::Distance
+BasicContractionHierarchy<Weight>::Search(int source, int target,
+                                          Workspace& workspace) const {
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+  if (source == target) return 0;
+
+  /* grows with the largest hierarchy this workspace served */
+  std::vector<Distance>& forward = workspace.forward;
+  std::vector<Distance>& backward = workspace.backward;
+  std::vector<int>& touched = workspace.touched;
+  if (forward.size() < Size()) {
+    forward.resize(Size(), INF);
+    backward.resize(Size(), INF);
+  }
+
+  using Entry = std::pair<Distance, int>;
+  using Heap =
+      std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>;
+  Heap heaps[2];
+  std::vector<Distance>* distances[2] = {&forward, &backward};
+
+  forward[source] = 0;
+  backward[target] = 0;
+  touched.push_back(source);
+  touched.push_back(target);
+  heaps[0].push({0, source});
+  heaps[1].push({0, target});
+
+  /* both searches climb the same upward arcs, the answer is the best
+   * vertex where they meet */
+  Distance best = INF;
+  while (true) {
+    const Distance top0 = heaps[0].empty() ? INF : heaps[0].top().first;
+    const Distance top1 = heaps[1].empty() ? INF : heaps[1].top().first;
+    if (std::min(top0, top1) >= best) break;
+
+    const int side = top0 <= top1 ? 0 : 1;
+    std::vector<Distance>& mine = *distances[side];
+    const std::vector<Distance>& other = *distances[1 - side];
+    const auto [distance, v] = heaps[side].top();
+    heaps[side].pop();
+    if (distance != mine[v]) continue;
+    if (other[v] != INF) best = std::min(best, distance + other[v]);
+
+    for (size_t e = up_offsets_[v]; e < up_offsets_[v + 1]; ++e) {
+      const int u = up_targets_[e];
+      const Distance candidate = distance + up_weights_[e];
+      if (candidate < mine[u]) {
+        if (mine[u] == INF) touched.push_back(u);
+        mine[u] = candidate;
+        heaps[side].push({candidate, u});
+      }
+    }
+  }
+
+  for (int v : touched) forward[v] = backward[v] = INF;
+  touched.clear();
+  return best;
+}
+
+template class BasicContractionHierarchy<uint8_t>;
+template class BasicContractionHierarchy<uint16_t>;
+template class BasicContractionHierarchy<int>;
+template class BasicContractionHierarchy<int64_t>;
@@ -0,0 +1,59 @@
+#ifndef S21_CONTRACTION_HIERARCHY_H_
+#define S21_CONTRACTION_HIERARCHY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+
+/* contraction hierarchy for static graphs: vertices are contracted in edge
+ * difference order, shortcuts keep the distances between the remaining ones
+ * and a query meets in the middle of two searches that only go upward */
+template <typename Weight>
+class BasicContractionHierarchy {
+ public:
+  using GraphType = BasicGraph<Weight>;
+  using Distance = typename WeightTraits<Weight>::Distance;
+
+  /* scratch space of one query: both distance arrays stay unreached
+   * between queries and only the vertices a search touched are reset;
+   * one per thread */
+  struct Workspace {
+    std::vector<Distance> forward;
+    std::vector<Distance> backward;
+    std::vector<int> touched;
+  };
+
+  BasicContractionHierarchy() = default;
+
+  bool Build(const GraphType& graph);
+  /* the hierarchy does not need the graph once built or loaded */
+  bool SaveBinary(const std::string& filename) const;
+  bool LoadBinary(const std::string& filename);
+
+  /* same contract as GraphAlgorithms::GetShortestPathBetweenVertices; the
+   * hierarchy is not modified, so one can serve concurrent queries */
+  int GetShortestPathBetweenVertices(int vertex1, int vertex2) const;
+  /* the overload above uses a workspace owned by the calling thread */
+  int GetShortestPathBetweenVertices(int vertex1, int vertex2,
+                                     Workspace& workspace) const;
+
+  size_t Size() const;
+  size_t ShortcutCount() const;
+
+ private:
+  Distance Search(int source, int target, Workspace& workspace) const;
+
+  /* contraction order, lower ranks were contracted first */
+  std::vector<int> rank_;
+  /* arcs to higher ranked vertices, original edges and shortcuts alike */
+  std::vector<size_t> up_offsets_;
+  std::vector<int> up_targets_;
+  std::vector<Distance> up_weights_;
+  size_t shortcuts_ = 0;
+};
+
+using ContractionHierarchy = BasicContractionHierarchy<int>;
+
+#endif  // S21_CONTRACTION_HIERARCHY_H_
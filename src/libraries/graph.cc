@@ -1,92 +1,549 @@
 #include <graph.h>
 
+#include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <utility>
 
-bool Graph::LoadGraphFromFile(const std::string& filename) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
+#include "mapped_file.h"
+#include "parallel.h"
+
+namespace {
+
+/* below this many bytes per worker splitting the parse is not worth it */
+constexpr size_t kMinParseChunk = 64 * 1024;
+
+/* shared by every graph of every weight type, 0 stays for empty graphs */
+std::atomic<uint64_t> version_counter{0};
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+
+/* parses the next whitespace separated token as an integer, the whole
+ * token has to be consumed */
+template <typename Integer>
+bool ParseToken(const char*& pos, const char* end, Integer& value) {
+  while (pos != end && IsSpace(*pos)) ++pos;
+  if (pos != end && *pos == '+') ++pos;
+  const auto [ptr, ec] = std::from_chars(pos, end, value);
+  if (ec != std::errc() || (ptr != end && !IsSpace(*ptr))) return false;
+  pos = ptr;
+  return true;
+}
+
+template <typename Weight>
+bool IsNegative(Weight weight) {
+  if constexpr (std::is_signed_v<Weight>) {
+    return weight < 0;
+  } else {
     return false;
   }
+}
+
+template <typename Weight>
+bool ParseWeights(const char*& pos, const char* end, Weight* out,
+                  size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    Weight weight = 0;
+    if (!ParseToken(pos, end, weight) || IsNegative(weight)) return false;
+    out[i] = weight;
+  }
+  return true;
+}
+
+size_t CountTokens(const char* pos, const char* end) {
+  size_t tokens = 0;
+  bool in_token = false;
+  for (; pos != end; ++pos) {
+    const bool space = IsSpace(*pos);
+    if (!space && !in_token) ++tokens;
+    in_token = !space;
+  }
+  return tokens;
+}
+
+/* fills the matrix with size * size weights, rows are split between threads
+ * on whitespace boundaries: the first pass counts tokens per chunk so that
+ * the second one knows where every chunk starts in the matrix */
+template <typename Weight>
+bool ParseMatrix(const char* begin, const char* end, Matrix<Weight>& matrix,
+                 unsigned threads) {
+  const size_t size = matrix.Rows();
+  const size_t count = size * size;
+  const size_t bytes = static_cast<size_t>(end - begin);
+  const size_t workers =
+      std::clamp<size_t>(bytes / kMinParseChunk, 1, threads == 0 ? 1 : threads);
+
+  if (workers == 1) {
+    for (size_t i = 0; i < size; ++i) {
+      if (!ParseWeights(begin, end, matrix.Row(i).data(), size)) return false;
+    }
+    return true;
+  }
+
+  std::vector<const char*> bounds(workers + 1, end);
+  bounds[0] = begin;
+  for (size_t w = 1; w < workers; ++w) {
+    const char* pos = std::max(begin + w * bytes / workers, bounds[w - 1]);
+    while (pos != end && !IsSpace(*pos)) ++pos;
+    bounds[w] = pos;
+  }
+
+  std::vector<size_t> first(workers + 1, 0);
+  ParallelFor(workers, static_cast<unsigned>(workers),
+              [&](unsigned, size_t from, size_t to) {
+                for (size_t w = from; w < to; ++w) {
+                  first[w + 1] = CountTokens(bounds[w], bounds[w + 1]);
+                }
+              });
+  for (size_t w = 0; w < workers; ++w) first[w + 1] += first[w];
+  if (first[workers] < count) return false;
+
+  std::vector<char> failed(workers, 0);
+  ParallelFor(workers, static_cast<unsigned>(workers),
+              [&](unsigned, size_t from, size_t to) {
+                for (size_t w = from; w < to; ++w) {
+                  const char* pos = bounds[w];
+                  const size_t last = std::min(first[w + 1], count);
+                  /* a chunk may start and end in the middle of a row */
+                  for (size_t k = first[w]; k < last && !failed[w];) {
+                    const size_t row = k / size;
+                    const size_t col = k % size;
+                    const size_t run = std::min(size - col, last - k);
+                    failed[w] = !ParseWeights(pos, bounds[w + 1],
+                                              &matrix(row, col), run);
+                    k += run;
+                  }
+                }
+              });
+  return std::find(failed.begin(), failed.end(), 1) == failed.end();
+}
+
+}  // namespace
+
+template <typename Weight>
+bool BasicGraph<Weight>::LoadGraphFromFile(const std::string& filename,
+                                           unsigned threads,
+                                           bool with_matrix) {
+  MappedFile file;
+  if (!file.Open(filename)) {
+    return false;
+  }
+  file.AdviseSequential();
+
+  const char* pos = file.Data();
+  const char* end = pos + file.Size();
 
   size_t size = 0;
-  file >> size;
+  if (!ParseToken(pos, end, size) || size == 0) {
+    return false;
+  }
+  /* every weight takes at least one byte, a smaller file is truncated */
+  if (size > static_cast<size_t>(end - pos) / size) {
+    return false;
+  }
+
+  Matrix<Weight> temp(size, size, 0);
+  if (!ParseMatrix(pos, end, temp, threads)) return false;
+
+  if (!ValidateGraph(temp, threads)) return false;
+
+  BasicGraph<Weight> loaded;
+  loaded.adjacency_matrix_ = std::move(temp);
+  loaded.BuildAdjacencyLists();
+  if (!DistancesFit(size, loaded.weights_.Span())) return false;
+  if (!with_matrix) loaded.adjacency_matrix_ = Matrix<Weight>();
+
+  Replace(std::move(loaded));
+  return true;
+}
 
-  if (file.fail() || size <= 0) {
+template <typename Weight>
+bool BasicGraph<Weight>::LoadGraphFromEdgeList(const std::string& filename) {
+  MappedFile file;
+  if (!file.Open(filename)) {
     return false;
   }
+  file.AdviseSequential();
 
-  std::vector<std::vector<int>> temp(size, std::vector<int>(size, 0));
-  for (size_t i = 0; i < size; ++i) {
-    for (size_t j = 0; j < size; ++j) {
-      int weight = 0;
-      file >> weight;
-      if (file.fail() || weight < 0) {
+  const char* pos = file.Data();
+  const char* end = pos + file.Size();
+
+  size_t size = 0;
+  if (!ParseToken(pos, end, size) || size == 0 ||
+      size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return false;
+  }
+
+  struct Entry {
+    int low;
+    int high;
+    Weight weight;
+    bool reversed;
+  };
+
+  /* every line is stored once, keyed by its unordered vertex pair */
+  std::vector<Entry> entries;
+  while (true) {
+    while (pos != end && IsSpace(*pos)) ++pos;
+    if (pos == end) break;
+
+    size_t from = 0;
+    size_t to = 0;
+    Weight weight = 0;
+    if (!ParseToken(pos, end, from) || !ParseToken(pos, end, to) ||
+        !ParseToken(pos, end, weight)) {
+      return false;
+    }
+    if (from == 0 || to == 0 || from > size || to > size || weight <= 0) {
+      return false;
+    }
+    const int u = static_cast<int>(from - 1);
+    const int v = static_cast<int>(to - 1);
+    entries.push_back({std::min(u, v), std::max(u, v), weight, u > v});
+  }
+  if (entries.empty()) return false;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+              if (a.low != b.low) return a.low < b.low;
+              if (a.high != b.high) return a.high < b.high;
+              return a.reversed < b.reversed;
+            });
+
+  /* a pair may be listed once, or twice in opposite directions with the
+   * same weight like in the matrix form; anything else is rejected */
+  size_t unique = 0;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const Entry& entry = entries[i];
+    if (i + 1 < entries.size() && entries[i + 1].low == entry.low &&
+        entries[i + 1].high == entry.high) {
+      const Entry& twin = entries[i + 1];
+      if (entry.low == entry.high || twin.reversed == entry.reversed ||
+          twin.weight != entry.weight) {
+        return false;
+      }
+      if (i + 2 < entries.size() && entries[i + 2].low == entry.low &&
+          entries[i + 2].high == entry.high) {
         return false;
       }
-      temp[i][j] = weight;
+      ++i;
     }
+    entries[unique++] = entry;
   }
+  entries.resize(unique);
 
-  if (!ValidateGraph(temp)) return false;
+  Buffer<size_t> offsets(size + 1, 0);
+  for (const Entry& entry : entries) {
+    ++offsets[entry.low + 1];
+    if (entry.low != entry.high) ++offsets[entry.high + 1];
+  }
+  for (size_t i = 0; i < size; ++i) offsets[i + 1] += offsets[i];
+
+  /* pairs are sorted, so every row is filled in increasing neighbor order */
+  Buffer<int> neighbors(offsets[size]);
+  Buffer<Weight> weights(offsets[size]);
+  std::vector<size_t> next(offsets.data(), offsets.data() + size);
+  for (const Entry& entry : entries) {
+    neighbors[next[entry.high]] = entry.low;
+    weights[next[entry.high]++] = entry.weight;
+    if (entry.low != entry.high) {
+      neighbors[next[entry.low]] = entry.high;
+      weights[next[entry.low]++] = entry.weight;
+    }
+  }
 
-  adjacency_matrix_ = std::move(temp);
+  if (!DistancesFit(size, weights.Span())) return false;
+
+  BasicGraph<Weight> loaded;
+  loaded.row_offsets_ = std::move(offsets);
+  loaded.neighbors_ = std::move(neighbors);
+  loaded.weights_ = std::move(weights);
+  Replace(std::move(loaded));
   return true;
 }
 
-bool Graph::ExportGraphToDot(const std::string& filename) {
-  if (adjacency_matrix_.empty()) return false;
+namespace {
+
+/* rows are formatted in chunks of roughly this many adjacency entries */
+constexpr size_t kDotChunkEntries = 1 << 15;
+
+template <typename Integer>
+void AppendNumber(std::string& out, Integer value) {
+  char digits[24];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  out.append(digits, result.ptr);
+}
+
+template <typename Weight>
+void FormatDotRows(const BasicGraph<Weight>& graph, size_t from, size_t to,
+                   std::string& out) {
+  out.clear();
+  for (size_t i = from; i < to; ++i) {
+    const auto neighbors = graph.Neighbors(i);
+    const auto weights = graph.NeighborWeights(i);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      const size_t j = static_cast<size_t>(neighbors[e]);
+      if (j > i) {
+        out.append("  ");
+        AppendNumber(out, i + 1);
+        out.append(" -- ");
+        AppendNumber(out, j + 1);
+        out.append(" [label=");
+        AppendNumber(out, weights[e]);
+        out.append("]\n");
+      }
+    }
+  }
+}
 
-  std::ofstream file(filename);
+}  // namespace
+
+template <typename Weight>
+bool BasicGraph<Weight>::ExportGraphToDot(const std::string& filename,
+                                          unsigned threads) const {
+  if (Size() == 0) return false;
+
+  std::ofstream file(filename, std::ios::binary);
 
   if (!file.is_open()) return false;
 
-  file << "graph G {\n";
+  return ExportGraphToDot(file, threads);
+}
 
-  const size_t size = adjacency_matrix_.size();
+template <typename Weight>
+bool BasicGraph<Weight>::ExportGraphToDot(std::ostream& out,
+                                          unsigned threads) const {
+  const size_t size = Size();
+  if (size == 0) return false;
+
+  /* row ranges holding about kDotChunkEntries entries each */
+  std::vector<size_t> bounds = {0};
+  size_t entries = 0;
   for (size_t i = 0; i < size; ++i) {
-    for (size_t j = i + 1; j < size; ++j) {
-      const int weight = adjacency_matrix_[i][j];
-      if (weight != 0) {
-        file << "  " << (i + 1) << " -- " << (j + 1) << " [label=" << weight
-             << "]\n";
-      }
+    entries += Neighbors(i).size();
+    if (entries >= kDotChunkEntries) {
+      bounds.push_back(i + 1);
+      entries = 0;
     }
   }
+  if (bounds.back() != size) bounds.push_back(size);
+  const size_t chunks = bounds.size() - 1;
 
-  file << "}\n";
-  return true;
+  /* every worker formats one chunk per round into its own buffer, the
+   * buffers are then written in row order */
+  const size_t workers = std::clamp<size_t>(threads, 1, chunks);
+  std::vector<std::string> buffers(workers);
+
+  out << "graph G {\n";
+  for (size_t first = 0; first < chunks && out; first += workers) {
+    const size_t round = std::min(workers, chunks - first);
+    ParallelFor(round, static_cast<unsigned>(round),
+                [&](unsigned, size_t from, size_t to) {
+                  for (size_t c = from; c < to; ++c) {
+                    FormatDotRows(*this, bounds[first + c],
+                                  bounds[first + c + 1], buffers[c]);
+                  }
+                });
+    for (size_t c = 0; c < round; ++c) {
+      out.write(buffers[c].data(),
+                static_cast<std::streamsize>(buffers[c].size()));
+    }
+  }
+  out << "}\n";
+
+  return static_cast<bool>(out);
 }
 
-bool Graph::ValidateGraph(const std::vector<std::vector<int>>& adj_matrix) {
-  size_t size = adj_matrix.size();
+namespace {
 
-  for (size_t i = 0; i < size; ++i) {
-    for (size_t j = i + 1; j < size; ++j) {
-      if (adj_matrix[i][j] != adj_matrix[j][i]) {
-        return false;
-      }
+/* 64 x 64 ints: a tile and its transposed copy together fit in L1 */
+constexpr size_t kValidationTile = 64;
+/* below this many matrix entries per worker a thread is not worth it */
+constexpr size_t kMinValidationEntries = 1 << 16;
+
+/* compares tile (row_tile, col_tile) with the transpose of
+ * (col_tile, row_tile), returns false on asymmetry and reports whether
+ * any weight in the upper tile is non-zero */
+template <typename Weight>
+bool CheckTilePair(const Matrix<Weight>& matrix, size_t row_tile,
+                   size_t col_tile, bool& has_edge) {
+  const size_t size = matrix.Rows();
+  const size_t row_begin = row_tile * kValidationTile;
+  const size_t col_begin = col_tile * kValidationTile;
+  const size_t rows = std::min(kValidationTile, size - row_begin);
+  const size_t cols = std::min(kValidationTile, size - col_begin);
+
+  Weight transposed[kValidationTile * kValidationTile];
+  for (size_t j = 0; j < cols; ++j) {
+    const Weight* source = &matrix(col_begin + j, row_begin);
+    for (size_t i = 0; i < rows; ++i) {
+      transposed[i * kValidationTile + j] = source[i];
     }
   }
 
-  bool has_edge = false;
-  for (size_t i = 0; i < size && !has_edge; ++i) {
-    for (size_t j = 0; j < size; ++j) {
-      if (adj_matrix[i][j] != 0) {
-        has_edge = true;
+  Weight difference = 0;
+  Weight any = 0;
+  for (size_t i = 0; i < rows; ++i) {
+    const Weight* row = &matrix(row_begin + i, col_begin);
+    const Weight* mirror = transposed + i * kValidationTile;
+    for (size_t j = 0; j < cols; ++j) {
+      difference |= row[j] ^ mirror[j];
+      any |= row[j];
+    }
+  }
+  has_edge = has_edge || any != 0;
+  return difference == 0;
+}
+
+}  // namespace
+
+/* single tiled pass over the upper triangle of tiles: each tile is compared
+ * against its transposed mirror while looking for an edge, tile rows are
+ * paired (first with last) so every worker gets the same amount of tiles */
+template <typename Weight>
+bool BasicGraph<Weight>::ValidateGraph(const Matrix<Weight>& adj_matrix,
+                                       unsigned threads) {
+  const size_t size = adj_matrix.size();
+  const size_t tiles = (size + kValidationTile - 1) / kValidationTile;
+  const size_t pairs = (tiles + 1) / 2;
+  const unsigned workers = static_cast<unsigned>(std::clamp<size_t>(
+      size * size / kMinValidationEntries, 1, threads == 0 ? 1 : threads));
+
+  std::atomic<bool> symmetric = true;
+  std::atomic<bool> has_edge = false;
+  ParallelFor(pairs, workers, [&](unsigned, size_t from, size_t to) {
+    bool found = false;
+    const auto check_row = [&](size_t row_tile) {
+      for (size_t col_tile = row_tile; col_tile < tiles; ++col_tile) {
+        if (!CheckTilePair(adj_matrix, row_tile, col_tile, found)) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    for (size_t p = from; p < to && symmetric.load(std::memory_order_relaxed);
+         ++p) {
+      const size_t mirror = tiles - 1 - p;
+      if (!check_row(p) || (mirror != p && !check_row(mirror))) {
+        symmetric = false;
         break;
       }
     }
+    if (found) has_edge = true;
+  });
+
+  return symmetric && has_edge;
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::BuildAdjacencyLists() {
+  const size_t size = adjacency_matrix_.size();
+
+  size_t edges = 0;
+  for (size_t i = 0; i < size; ++i) {
+    for (Weight weight : adjacency_matrix_.Row(i)) {
+      if (weight != 0) ++edges;
+    }
   }
-  if (!has_edge) {
-    return false;
+
+  Buffer<size_t> offsets(size + 1, 0);
+  Buffer<int> neighbors(edges);
+  Buffer<Weight> weights(edges);
+
+  size_t position = 0;
+  for (size_t i = 0; i < size; ++i) {
+    offsets[i] = position;
+    const auto row = adjacency_matrix_.Row(i);
+    for (size_t j = 0; j < size; ++j) {
+      if (row[j] != 0) {
+        neighbors[position] = static_cast<int>(j);
+        weights[position] = row[j];
+        ++position;
+      }
+    }
   }
+  offsets[size] = position;
 
-  return true;
+  row_offsets_ = std::move(offsets);
+  neighbors_ = std::move(neighbors);
+  weights_ = std::move(weights);
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::Replace(BasicGraph<Weight>&& loaded) {
+  loaded.version_ = NextVersion();
+  *this = std::move(loaded);
+}
+
+template <typename Weight>
+uint64_t BasicGraph<Weight>::NextVersion() {
+  return version_counter.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
-const std::vector<std::vector<int>>& Graph::GetAdjecencyMatrix() const {
+template <typename Weight>
+size_t BasicGraph<Weight>::EdgeCount() const {
+  return row_degrees_.empty() ? neighbors_.size() : live_entries_;
+}
+
+template <typename Weight>
+uint64_t BasicGraph<Weight>::Version() const {
+  return version_;
+}
+
+template <typename Weight>
+size_t BasicGraph<Weight>::Degree(size_t vertex) const {
+  return row_degrees_.empty() ? row_offsets_[vertex + 1] - row_offsets_[vertex]
+                              : row_degrees_[vertex];
+}
+
+template <typename Weight>
+std::span<const int> BasicGraph<Weight>::Neighbors(size_t vertex) const {
+  return neighbors_.Span().subspan(row_offsets_[vertex], Degree(vertex));
+}
+
+template <typename Weight>
+std::span<const Weight> BasicGraph<Weight>::NeighborWeights(
+    size_t vertex) const {
+  return weights_.Span().subspan(row_offsets_[vertex], Degree(vertex));
+}
+
+template <typename Weight>
+const Matrix<Weight>& BasicGraph<Weight>::GetAdjecencyMatrix() const {
   return adjacency_matrix_;
 }
 
-size_t Graph::Size() const { return adjacency_matrix_.size(); }
+template <typename Weight>
+size_t BasicGraph<Weight>::Size() const {
+  return row_offsets_.empty() ? 0 : row_offsets_.size() - 1;
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::HasAdjacencyMatrix() const {
+  return !adjacency_matrix_.empty();
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::DistancesFit(size_t size,
+                                      std::span<const Weight> weights) {
+  using Distance = typename WeightTraits<Weight>::Distance;
+  const Distance limit =
+      WeightTraits<Weight>::kInfinity / static_cast<Distance>(size);
+  /* no scan while the widest weight fits, for uint8_t that holds below
+   * 4,194,304 vertices, for wider types it depends on their range */
+  if (std::cmp_less(std::numeric_limits<Weight>::max(), limit)) return true;
+  return std::all_of(weights.begin(), weights.end(), [limit](Weight weight) {
+    return std::cmp_less(weight, limit);
+  });
+}
+
+template class BasicGraph<uint8_t>;
+template class BasicGraph<uint16_t>;
+template class BasicGraph<int>;
+template class BasicGraph<int64_t>;
@@ -1,23 +1,129 @@
 #ifndef S21_GRAPH_H_
 #define S21_GRAPH_H_
 
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
-class Graph {
+#include "buffer.h"
+#include "matrix.h"
+#include "parallel.h"
+
+/* accumulation type for path lengths over a given weight type, single byte
+ * weights sum up in 32 bits, everything wider in 64 bits; kInfinity leaves
+ * room for one more addition so relaxations never overflow. Loading
+ * requires every weight to stay below kInfinity / V, which limits uint8_t
+ * graphs: weights up to 255 fit below 4,194,304 vertices, at 10 million
+ * vertices only weights below 107 do */
+template <typename Weight>
+struct WeightTraits {
+  static_assert(std::is_integral_v<Weight> && sizeof(Weight) <= 8);
+
+  using Distance =
+      std::conditional_t<sizeof(Weight) == 1, int32_t, long long>;
+  static constexpr Distance kInfinity =
+      std::numeric_limits<Distance>::max() / 2;
+};
+
+/* weighted undirected graph, instantiated for uint8_t, uint16_t, int and
+ * int64_t weights */
+template <typename Weight>
+class BasicGraph {
  public:
-  Graph() = default;
+  using WeightType = Weight;
+  using Distance = typename WeightTraits<Weight>::Distance;
+
+  BasicGraph() = default;
+
+  /* memory maps the file, then parses and validates it; large files are
+   * split between threads, small ones stay on one. Without with_matrix the
+   * dense matrix is released once the lists are built, so the loaded graph
+   * takes memory in proportion to its edges */
+  bool LoadGraphFromFile(const std::string& filename,
+                         unsigned threads = HardwareThreads(),
+                         bool with_matrix = true);
+  /* edge list: the vertex count followed by "u v w" lines with 1-based
+   * vertices; the graph is built straight into adjacency lists, without the
+   * dense matrix */
+  bool LoadGraphFromEdgeList(const std::string& filename);
+  /* rows are formatted into per-thread buffers and written in order, the
+   * stream overload writes to any sink */
+  bool ExportGraphToDot(const std::string& filename,
+                        unsigned threads = HardwareThreads()) const;
+  bool ExportGraphToDot(std::ostream& out,
+                        unsigned threads = HardwareThreads()) const;
+
+  /* binary snapshot: a versioned, checksummed header followed by the
+   * adjacency lists and, optionally, the dense matrix; loading maps the file
+   * and uses the sections in place */
+  bool SaveBinary(const std::string& filename, bool with_matrix = true) const;
+  bool LoadBinary(const std::string& filename, bool verify_checksum = true);
 
-  bool LoadGraphFromFile(const std::string& filename);
-  bool ExportGraphToDot(const std::string& filename);
+  /* in-place updates with 1-based vertices, both directions and the dense
+   * matrix (if any) are kept in sync; a row that runs out of room moves to
+   * the end of the lists, so changes cost O(degree); the last edge cannot
+   * be removed and weights have to stay positive */
+  bool AddEdge(int vertex1, int vertex2, Weight weight);
+  bool RemoveEdge(int vertex1, int vertex2);
+  bool SetWeight(int vertex1, int vertex2, Weight weight);
+  /* drawn from a process-wide counter by every load and every successful
+   * update, so no two graph states share a version; copies share it until
+   * either one changes */
+  uint64_t Version() const;
 
   size_t Size() const;
-  const std::vector<std::vector<int>>& GetAdjecencyMatrix() const;
+  /* empty for graphs loaded without their dense form */
+  bool HasAdjacencyMatrix() const;
+  const Matrix<Weight>& GetAdjecencyMatrix() const;
+
+  /* compressed sparse row view, neighbors of each vertex are sorted */
+  size_t EdgeCount() const;
+  std::span<const int> Neighbors(size_t vertex) const;
+  std::span<const Weight> NeighborWeights(size_t vertex) const;
+  size_t Degree(size_t vertex) const;
 
  private:
-  std::vector<std::vector<int>> adjacency_matrix_;
+  Matrix<Weight> adjacency_matrix_;
+
+  Buffer<size_t> row_offsets_;
+  Buffer<int> neighbors_;
+  Buffer<Weight> weights_;
+
+  /* filled after the first update: rows are no longer packed back to back,
+   * row_offsets_ then only holds where each row starts */
+  std::vector<size_t> row_degrees_;
+  std::vector<size_t> row_capacities_;
+  size_t live_entries_ = 0;
 
-  bool ValidateGraph(const std::vector<std::vector<int>>& adj_matrix);
+  uint64_t version_ = 0;
+
+  bool ValidateGraph(const Matrix<Weight>& adj_matrix, unsigned threads);
+  void BuildAdjacencyLists();
+  void Replace(BasicGraph<Weight>&& loaded);
+  /* next value of the process-wide version counter, never 0 */
+  static uint64_t NextVersion();
+
+  bool ValidEdge(int vertex1, int vertex2) const;
+  bool ValidWeight(Weight weight) const;
+  void Unpack();
+  void Compact();
+  void InsertEntry(size_t row, int neighbor, Weight weight);
+  void EraseEntry(size_t row, size_t position);
+  /* position of neighbor in the row, or the row's degree */
+  size_t FindEntry(size_t row, int neighbor) const;
+  void SetMatrixWeight(size_t row, size_t col, Weight weight);
+  /* no simple path may add up to WeightTraits::kInfinity, see there for
+   * the limit this puts on uint8_t graphs */
+  static bool DistancesFit(size_t size, std::span<const Weight> weights);
 };
 
-#endif  // S21_GRAPH_H_
\ No newline at end of file
+using Graph = BasicGraph<int>;
+using Graph8 = BasicGraph<uint8_t>;
+using Graph16 = BasicGraph<uint16_t>;
+using Graph64 = BasicGraph<int64_t>;
+
+#endif  // S21_GRAPH_H_
@@ -1,7 +1,176 @@
 #include "graph_algorithms.h"
 
-std::vector<int> GraphAlgorithms::DepthFirstSearch(const Graph& graph,
-                                                   int start_vertex) {
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+#include "bitset.h"
+
+namespace {
+
+/* Floyd-Warshall tile side, three tiles of 64-bit distances fit in L1 */
+constexpr size_t kFloydTile = 32;
+
+/* the min-plus kernel gets an AVX2 clone picked at load time where the
+ * loader supports it, 64-bit minimums do not vectorize on baseline x86-64 */
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__)
+#define S21_VECTOR_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define S21_VECTOR_CLONES
+#endif
+
+/* d[i][j] = min(d[i][j], d[i][k] + d[k][j]) over one tile of rows i, one of
+ * columns j and one of steps k; distances never exceed kInfinity, half the
+ * type's range, so a sum through an unreachable vertex saturates above it
+ * instead of overflowing and the fixed length inner loop stays branch-free
+ * for the vectorizer. Row k itself is skipped: with d[k][k] = 0 its update
+ * is a no-op, and without it the two rows never alias */
+template <typename Distance>
+inline void MinPlusRow(Distance* __restrict row,
+                       const Distance* __restrict through, Distance to_k) {
+  for (size_t j = 0; j < kFloydTile; ++j) {
+    row[j] = std::min(row[j], to_k + through[j]);
+  }
+}
+
+template <typename Distance>
+S21_VECTOR_CLONES void MinPlusTile(Distance* d, size_t stride, size_t i0,
+                                   size_t j0, size_t k0) {
+  for (size_t k = k0; k < k0 + kFloydTile; ++k) {
+    for (size_t i = i0; i < i0 + kFloydTile; ++i) {
+      if (i == k) continue;
+      MinPlusRow(d + i * stride + j0, d + k * stride + j0, d[i * stride + k]);
+    }
+  }
+}
+
+/* an edge considered for a spanning tree with from < to; the full key is a
+ * strict order, so Kruskal and Boruvka pick the same edges whatever the
+ * number of threads and Boruvka's picks never close a cycle */
+template <typename Weight>
+struct CandidateEdge {
+  Weight weight;
+  int from;
+  int to;
+
+  bool operator<(const CandidateEdge& other) const {
+    return std::tie(weight, from, to) <
+           std::tie(other.weight, other.from, other.to);
+  }
+};
+
+/* the targets of one search, counted down as they are settled; a single
+ * target is compared directly, more are marked in a per-vertex table */
+class TargetSet {
+ public:
+  TargetSet(size_t size, std::span<const int> targets)
+      : targets_(targets), remaining_(targets.size()) {
+    if (targets.size() < 2) return;
+    wanted_.assign(size, 0);
+    remaining_ = 0;
+    for (int t : targets) {
+      if (!wanted_[t]) ++remaining_;
+      wanted_[t] = 1;
+    }
+  }
+
+  /* true once v was the last target left to settle */
+  bool Settle(int v) {
+    if (remaining_ == 0) return false;
+    if (wanted_.empty()) {
+      if (v != targets_[0]) return false;
+    } else {
+      if (!wanted_[v]) return false;
+      wanted_[v] = 0;
+    }
+    return --remaining_ == 0;
+  }
+
+ private:
+  std::span<const int> targets_;
+  size_t remaining_;
+  std::vector<char> wanted_;
+};
+
+/* union-find with path compression and union by rank */
+class DisjointSets {
+ public:
+  explicit DisjointSets(size_t size) : parent_(size), rank_(size, 0) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+  }
+
+  int Find(int v) {
+    int root = v;
+    while (parent_[root] != root) root = parent_[root];
+    while (parent_[v] != root) v = std::exchange(parent_[v], root);
+    return root;
+  }
+
+  /* false if both already were in one set */
+  bool Unite(int a, int b) {
+    a = Find(a);
+    b = Find(b);
+    if (a == b) return false;
+    if (rank_[a] < rank_[b]) std::swap(a, b);
+    parent_[b] = a;
+    if (rank_[a] == rank_[b]) ++rank_[a];
+    return true;
+  }
+
+ private:
+  std::vector<int> parent_;
+  std::vector<uint8_t> rank_;
+};
+
+/* union-find shared between threads: a root is linked under the larger one
+ * with a CAS and finds halve paths as they go, a lost race only costs a
+ * retry or some compression */
+class ConcurrentDisjointSets {
+ public:
+  explicit ConcurrentDisjointSets(size_t size) : parent_(size) {
+    for (size_t v = 0; v < size; ++v) parent_[v].store(static_cast<int>(v));
+  }
+
+  int Find(int v) {
+    while (true) {
+      int parent = parent_[v].load();
+      if (parent == v) return v;
+      const int grandparent = parent_[parent].load();
+      if (parent != grandparent) {
+        parent_[v].compare_exchange_weak(parent, grandparent);
+      }
+      v = grandparent;
+    }
+  }
+
+  /* false if both already were in one set */
+  bool Unite(int a, int b) {
+    while (true) {
+      a = Find(a);
+      b = Find(b);
+      if (a == b) return false;
+      if (a > b) std::swap(a, b);
+      int root = a;
+      if (parent_[a].compare_exchange_strong(root, b)) return true;
+    }
+  }
+
+ private:
+  std::vector<std::atomic<int>> parent_;
+};
+
+}  // namespace
+
+template <typename Weight>
+std::vector<int> BasicGraphAlgorithms<Weight>::DepthFirstSearch(
+    const GraphType& graph, int start_vertex) {
   std::vector<int> distance;
   const size_t size = graph.Size();
   if (size == 0 || start_vertex < 1 ||
@@ -9,8 +178,6 @@ std::vector<int> GraphAlgorithms::DepthFirstSearch(const Graph& graph,
     return distance;
   }
 
-  const auto& matrix = graph.GetAdjecencyMatrix();
-
   std::vector<bool> visited(size, false);
   s21::Stack<int> stack;
 
@@ -26,9 +193,11 @@ std::vector<int> GraphAlgorithms::DepthFirstSearch(const Graph& graph,
     visited[v] = true;
 
     distance.push_back(v + 1);
-    for (int u = static_cast<int>(size) - 1; u >= 0; --u) {
-      if (matrix[v][u] != 0 && !visited[u]) {
-        stack.push(u);
+    /* pushing in reverse so that lower vertices are visited first */
+    const auto neighbors = graph.Neighbors(v);
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+      if (!visited[*it]) {
+        stack.push(*it);
       }
     }
   }
@@ -36,8 +205,9 @@ std::vector<int> GraphAlgorithms::DepthFirstSearch(const Graph& graph,
   return distance;
 }
 
-std::vector<int> GraphAlgorithms::BreadthFirstSearch(const Graph& graph,
-                                                     int start_vertex) {
+template <typename Weight>
+std::vector<int> BasicGraphAlgorithms<Weight>::BreadthFirstSearch(
+    const GraphType& graph, int start_vertex, BfsMode mode) {
   std::vector<int> distance;
   const size_t size = graph.Size();
   if (size == 0 || start_vertex < 1 ||
@@ -45,12 +215,14 @@ std::vector<int> GraphAlgorithms::BreadthFirstSearch(const Graph& graph,
     return distance;
   }
 
-  const auto& matrix = graph.GetAdjecencyMatrix();
+  const int start = start_vertex - 1;
+  if (mode == BfsMode::kDirectionOptimizing) {
+    return VisitOrder(graph, start, DirectionOptimizingLevels(graph, start));
+  }
 
   std::vector<bool> visited(size, false);
   s21::Queue<int> queue;
 
-  const int start = start_vertex - 1;
   visited[start] = true;
   queue.push(start);
 
@@ -60,10 +232,10 @@ std::vector<int> GraphAlgorithms::BreadthFirstSearch(const Graph& graph,
     queue.pop();
     distance.push_back(v + 1);
 
-    for (size_t u = 0; u < size; ++u) {
-      if (matrix[v][u] != 0 && !visited[u]) {
+    for (int u : graph.Neighbors(v)) {
+      if (!visited[u]) {
         visited[u] = true;
-        queue.push(static_cast<int>(u));
+        queue.push(u);
       }
     }
   }
@@ -71,8 +243,271 @@ std::vector<int> GraphAlgorithms::BreadthFirstSearch(const Graph& graph,
   return distance;
 }
 
-int GraphAlgorithms::GetShortestPathBetweenVertices(const Graph& graph,
-                                                    int vertex1, int vertex2) {
+template <typename Weight>
+std::vector<int> BasicGraphAlgorithms<Weight>::GetHopDistances(
+    const GraphType& graph, int start_vertex) {
+  const size_t size = graph.Size();
+  if (size == 0 || start_vertex < 1 ||
+      static_cast<size_t>(start_vertex) > size) {
+    return {};
+  }
+  return DirectionOptimizingLevels(graph, start_vertex - 1);
+}
+
+template <typename Weight>
+std::vector<int> BasicGraphAlgorithms<Weight>::DirectionOptimizingLevels(
+    const GraphType& graph, int start) {
+  /* go bottom-up once the frontier has more than 1 / kAlpha of the edges
+   * left to explore, back top-down below 1 / kBeta of the vertices */
+  constexpr size_t kAlpha = 14;
+  constexpr size_t kBeta = 24;
+  const size_t size = graph.Size();
+
+  std::vector<int> level(size, -1);
+  Bitset visited(size);
+  /* top-down steps walk a list, bottom-up steps test a bitset */
+  std::vector<int> frontier = {start};
+  std::vector<int> next;
+  Bitset frontier_bits(size);
+  Bitset next_bits(size);
+  bool bottom_up = false;
+
+  level[start] = 0;
+  visited.Set(start);
+  size_t frontier_size = 1;
+  size_t unexplored_edges = graph.EdgeCount() - graph.Degree(start);
+
+  for (int depth = 1; frontier_size > 0; ++depth) {
+    if (!bottom_up) {
+      size_t frontier_edges = 0;
+      for (int v : frontier) frontier_edges += graph.Degree(v);
+      if (frontier_edges > unexplored_edges / kAlpha) {
+        bottom_up = true;
+        frontier_bits.Clear();
+        for (int v : frontier) frontier_bits.Set(v);
+      }
+    } else if (frontier_size < size / kBeta) {
+      bottom_up = false;
+      frontier.clear();
+      frontier_bits.ForEachSet([&](size_t v) { frontier.push_back(v); });
+    }
+
+    const auto reach = [&](int u) {
+      visited.Set(u);
+      level[u] = depth;
+      unexplored_edges -= graph.Degree(u);
+    };
+    if (bottom_up) {
+      /* vertices found in this step are not in the frontier bitset, so
+       * marking them while sweeping does not change the step */
+      next_bits.Clear();
+      frontier_size = 0;
+      visited.ForEachClear([&](size_t u) {
+        for (int w : graph.Neighbors(u)) {
+          if (!frontier_bits.Test(w)) continue;
+          reach(static_cast<int>(u));
+          next_bits.Set(u);
+          ++frontier_size;
+          break;
+        }
+      });
+      std::swap(frontier_bits, next_bits);
+    } else {
+      next.clear();
+      for (int v : frontier) {
+        for (int u : graph.Neighbors(v)) {
+          if (visited.Test(u)) continue;
+          reach(u);
+          next.push_back(u);
+        }
+      }
+      frontier.swap(next);
+      frontier_size = frontier.size();
+    }
+  }
+  return level;
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::BfsTree
+BasicGraphAlgorithms<Weight>::GetBfsTree(const GraphType& graph,
+                                         int start_vertex, unsigned threads) {
+  const size_t size = graph.Size();
+  if (size == 0 || start_vertex < 1 ||
+      static_cast<size_t>(start_vertex) > size) {
+    return {};
+  }
+
+  const int start = start_vertex - 1;
+  BfsTree tree{std::vector<int>(size, -1), std::vector<int>(size, -1)};
+  std::vector<std::atomic<uint64_t>> visited((size + 63) / 64);
+  visited[start / 64].store(uint64_t{1} << (start % 64));
+  tree.distance[start] = 0;
+
+  const size_t workers = std::clamp<size_t>(threads, 1, size);
+  std::vector<int> frontier = {start};
+  std::vector<std::vector<int>> next(workers);
+  int depth = 0;
+
+  /* runs once per level after every worker arrived and before any leaves,
+   * so the frontier only changes while nobody reads it */
+  const auto gather = [&]() noexcept {
+    frontier.clear();
+    for (auto& local : next) {
+      frontier.insert(frontier.end(), local.begin(), local.end());
+      local.clear();
+    }
+    ++depth;
+  };
+  std::barrier level(static_cast<std::ptrdiff_t>(workers), gather);
+
+  ParallelFor(workers, static_cast<unsigned>(workers),
+              [&](unsigned worker, size_t, size_t) {
+                while (!frontier.empty()) {
+                  const size_t count = frontier.size();
+                  const size_t end = (worker + 1) * count / workers;
+                  for (size_t i = worker * count / workers; i < end; ++i) {
+                    const int v = frontier[i];
+                    for (int u : graph.Neighbors(v)) {
+                      std::atomic<uint64_t>& word = visited[u / 64];
+                      const uint64_t bit = uint64_t{1} << (u % 64);
+                      /* a plain load filters most visited vertices, the
+                       * atomic or lets exactly one worker claim the rest */
+                      if ((word.load(std::memory_order_relaxed) & bit) ||
+                          (word.fetch_or(bit) & bit)) {
+                        continue;
+                      }
+                      tree.distance[u] = depth + 1;
+                      tree.parent[u] = v;
+                      next[worker].push_back(u);
+                    }
+                  }
+                  level.arrive_and_wait();
+                }
+              });
+  return tree;
+}
+
+template <typename Weight>
+Matrix<int> BasicGraphAlgorithms<Weight>::GetHopDistanceTable(
+    const GraphType& graph, const std::vector<int>& sources,
+    unsigned threads) {
+  const size_t size = graph.Size();
+  if (size == 0 || !std::all_of(sources.begin(), sources.end(), [size](int v) {
+        return v >= 1 && static_cast<size_t>(v) <= size;
+      })) {
+    return {};
+  }
+
+  Matrix<int> table(sources.size(), size, -1);
+  const size_t batches = (sources.size() + 63) / 64;
+  ParallelFor(batches, threads, [&](unsigned, size_t begin, size_t end) {
+    for (size_t b = begin; b < end; ++b) {
+      const size_t row = b * 64;
+      MultiSourceBfs(graph, sources.data() + row,
+                     std::min<size_t>(64, sources.size() - row), table, row);
+    }
+  });
+  return table;
+}
+
+template <typename Weight>
+void BasicGraphAlgorithms<Weight>::MultiSourceBfs(const GraphType& graph,
+                                                  const int* sources,
+                                                  size_t count,
+                                                  Matrix<int>& table,
+                                                  size_t row) {
+  const size_t size = graph.Size();
+  /* bit i of a mask stands for the search from sources[i] */
+  std::vector<uint64_t> seen(size, 0);
+  std::vector<uint64_t> visit(size, 0);
+  std::vector<uint64_t> next(size, 0);
+
+  for (size_t i = 0; i < count; ++i) {
+    const int v = sources[i] - 1;
+    seen[v] |= uint64_t{1} << i;
+    visit[v] |= uint64_t{1} << i;
+    table(row + i, v) = 0;
+  }
+
+  bool active = true;
+  for (int depth = 1; active; ++depth) {
+    /* every search at a vertex moves along each edge at once */
+    for (size_t v = 0; v < size; ++v) {
+      if (visit[v] == 0) continue;
+      for (int u : graph.Neighbors(v)) next[u] |= visit[v];
+    }
+
+    active = false;
+    for (size_t u = 0; u < size; ++u) {
+      const uint64_t reached = next[u] & ~seen[u];
+      next[u] = 0;
+      visit[u] = reached;
+      if (reached == 0) continue;
+      active = true;
+      seen[u] |= reached;
+      for (uint64_t bits = reached; bits != 0; bits &= bits - 1) {
+        table(row + std::countr_zero(bits), u) = depth;
+      }
+    }
+  }
+}
+
+template <typename Weight>
+std::vector<int> BasicGraphAlgorithms<Weight>::VisitOrder(
+    const GraphType& graph, int start, const std::vector<int>& level) {
+  const size_t size = graph.Size();
+  const int depth = *std::max_element(level.begin(), level.end());
+
+  /* reached vertices grouped by level, ascending within each */
+  std::vector<size_t> offsets(depth + 2, 0);
+  for (int l : level) {
+    if (l >= 0) ++offsets[l + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<int> by_level(offsets.back());
+  std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t v = 0; v < size; ++v) {
+    if (level[v] >= 0) by_level[fill[level[v]]++] = static_cast<int>(v);
+  }
+
+  /* the queue dequeues a level in order, each vertex appends its unseen
+   * neighbors, so a vertex is placed by its first parent in that order.
+   * Neighbors of level l are on levels l - 1 to l + 1 and only the first
+   * are placed, so the smallest position among all of them is the parent */
+  constexpr size_t kUnplaced = std::numeric_limits<size_t>::max();
+  std::vector<int> order = {start + 1};
+  order.reserve(offsets.back());
+  std::vector<size_t> position(size, kUnplaced);
+  position[start] = 0;
+  std::vector<size_t> parent(by_level.size());
+  std::vector<size_t> children;
+  for (int l = 1; l <= depth; ++l) {
+    const size_t first_parent = offsets[l - 1];
+    children.assign(offsets[l] - first_parent + 1, 0);
+    for (size_t i = offsets[l]; i < offsets[l + 1]; ++i) {
+      size_t closest = kUnplaced;
+      for (int w : graph.Neighbors(by_level[i])) {
+        closest = std::min(closest, position[w]);
+      }
+      parent[i] = closest - first_parent;
+      ++children[parent[i] + 1];
+    }
+    /* counting sort by parent, ascending ids within one parent */
+    std::partial_sum(children.begin(), children.end(), children.begin());
+    order.resize(offsets[l + 1]);
+    for (size_t i = offsets[l]; i < offsets[l + 1]; ++i) {
+      const size_t at = offsets[l] + children[parent[i]]++;
+      order[at] = by_level[i] + 1;
+      position[by_level[i]] = at;
+    }
+  }
+  return order;
+}
+
+template <typename Weight>
+int BasicGraphAlgorithms<Weight>::GetShortestPathBetweenVertices(
+    const GraphType& graph, int vertex1, int vertex2, DijkstraMode mode) {
   const size_t size = graph.Size();
   if (size == 0 || vertex1 < 1 || vertex2 < 1 ||
       static_cast<size_t>(vertex1) > size ||
@@ -80,16 +515,126 @@ int GraphAlgorithms::GetShortestPathBetweenVertices(const Graph& graph,
     return -1;
   }
 
-  using Distance = long long;
-  const Distance INF = 1e18;
-
-  const auto& matrix = graph.GetAdjecencyMatrix();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
 
   const int start = vertex1 - 1;
   const int finish = vertex2 - 1;
 
+  if (mode == DijkstraMode::kAuto && IsSparse(graph)) {
+    mode = DijkstraMode::kBidirectional;
+  }
+  const Distance distance =
+      mode == DijkstraMode::kBidirectional
+          ? BidirectionalDijkstra(graph, start, finish)
+          : RunDijkstra(graph, start, std::span<const int>(&finish, 1), mode)
+                .distance[finish];
+
+  if (std::cmp_greater(distance, std::numeric_limits<int>::max())) {
+    return -1;
+  }
+  return (distance == INF) ? -1 : distance;
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::ShortestPathTree
+BasicGraphAlgorithms<Weight>::GetShortestPathTree(const GraphType& graph,
+                                                  int source, int target,
+                                                  DijkstraMode mode) {
+  const size_t size = graph.Size();
+  if (size == 0 || source < 1 || static_cast<size_t>(source) > size ||
+      target < 0 || static_cast<size_t>(target) > size) {
+    return {};
+  }
+  const int finish = target - 1;
+  return RunDijkstra(graph, source - 1,
+                     std::span<const int>(&finish, target == 0 ? 0 : 1),
+                     mode);
+}
+
+template <typename Weight>
+std::vector<int> BasicGraphAlgorithms<Weight>::GetShortestPath(
+    const ShortestPathTree& tree, int target) {
+  std::vector<int> path;
+  if (target < 1 || static_cast<size_t>(target) > tree.distance.size() ||
+      tree.distance[target - 1] == WeightTraits<Weight>::kInfinity) {
+    return path;
+  }
+  for (int v = target - 1; v != -1; v = tree.predecessor[v]) {
+    path.push_back(v + 1);
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+template <typename Weight>
+Matrix<typename BasicGraphAlgorithms<Weight>::Distance>
+BasicGraphAlgorithms<Weight>::GetDistanceTable(const GraphType& graph,
+                                               const std::vector<int>& sources,
+                                               const std::vector<int>& targets,
+                                               unsigned threads) {
+  const size_t size = graph.Size();
+  const auto valid = [size](int v) {
+    return v >= 1 && static_cast<size_t>(v) <= size;
+  };
+  if (size == 0 || !std::all_of(sources.begin(), sources.end(), valid) ||
+      !std::all_of(targets.begin(), targets.end(), valid)) {
+    return {};
+  }
+
+  Matrix<Distance> table(sources.size(), targets.size(),
+                         WeightTraits<Weight>::kInfinity);
+  if (targets.empty()) return table;
+  /* each search stops once the last target is settled */
+  std::vector<int> finish(targets.size());
+  for (size_t j = 0; j < targets.size(); ++j) finish[j] = targets[j] - 1;
+
+  /* every row is written by the worker that owns its source */
+  ParallelFor(sources.size(), threads,
+              [&](unsigned, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                  const ShortestPathTree tree = RunDijkstra(
+                      graph, sources[i] - 1, finish, DijkstraMode::kAuto);
+                  const auto row = table.Row(i);
+                  for (size_t j = 0; j < targets.size(); ++j) {
+                    row[j] = tree.distance[targets[j] - 1];
+                  }
+                }
+              });
+  return table;
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::ShortestPathTree
+BasicGraphAlgorithms<Weight>::RunDijkstra(const GraphType& graph, int start,
+                                          std::span<const int> targets,
+                                          DijkstraMode mode) {
+  if (mode == DijkstraMode::kAuto) {
+    mode = IsSparse(graph) ? DijkstraMode::kHeap : DijkstraMode::kDense;
+  }
+  return mode == DijkstraMode::kDense ? DenseDijkstra(graph, start, targets)
+                                      : HeapDijkstra(graph, start, targets);
+}
+
+template <typename Weight>
+bool BasicGraphAlgorithms<Weight>::IsSparse(const GraphType& graph) {
+  /* the heap pays about log V per relaxation, the linear scan pays V for
+   * every settled vertex */
+  const size_t size = graph.Size();
+  return graph.EdgeCount() * std::bit_width(size) < size * size;
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::ShortestPathTree
+BasicGraphAlgorithms<Weight>::DenseDijkstra(const GraphType& graph, int start,
+                                            std::span<const int> targets) {
+  const size_t size = graph.Size();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+  TargetSet pending(size, targets);
+
   /* trying to prevent possible overflow */
-  std::vector<Distance> distance(size, INF);
+  ShortestPathTree tree{std::vector<Distance>(size, INF),
+                        std::vector<int>(size, -1)};
+  auto& distance = tree.distance;
   std::vector<bool> visited(size, false);
 
   distance[start] = 0;
@@ -105,77 +650,346 @@ int GraphAlgorithms::GetShortestPathBetweenVertices(const Graph& graph,
     if (v == -1 || distance[v] == INF) break;
 
     visited[v] = true;
+    if (pending.Settle(v)) break;
 
-    for (size_t u = 0; u < size; ++u) {
-      if (!visited[u] && matrix[v][u] > 0) {
-        distance[u] = std::min(distance[v] + matrix[v][u], distance[u]);
+    const auto neighbors = graph.Neighbors(v);
+    const auto weights = graph.NeighborWeights(v);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      const int u = neighbors[e];
+      if (!visited[u] && distance[v] + weights[e] < distance[u]) {
+        distance[u] = distance[v] + weights[e];
+        tree.predecessor[u] = v;
       }
     }
   }
-  if (distance[finish] > std::numeric_limits<int>::max()) {
-    return -1;
+  return tree;
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::ShortestPathTree
+BasicGraphAlgorithms<Weight>::HeapDijkstra(const GraphType& graph, int start,
+                                           std::span<const int> targets) {
+  const size_t size = graph.Size();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+  TargetSet pending(size, targets);
+
+  using Entry = std::pair<Distance, int>;
+  ShortestPathTree tree{std::vector<Distance>(size, INF),
+                        std::vector<int>(size, -1)};
+  auto& distance = tree.distance;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+  distance[start] = 0;
+  heap.push({0, start});
+
+  /* lazy deletion: stale entries are skipped when popped */
+  while (!heap.empty()) {
+    const auto [d, v] = heap.top();
+    heap.pop();
+    if (d != distance[v]) continue;
+    if (pending.Settle(v)) break;
+
+    const auto neighbors = graph.Neighbors(v);
+    const auto weights = graph.NeighborWeights(v);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      const int u = neighbors[e];
+      const Distance candidate = d + weights[e];
+      if (candidate < distance[u]) {
+        distance[u] = candidate;
+        tree.predecessor[u] = v;
+        heap.push({candidate, u});
+      }
+    }
+  }
+  return tree;
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::Distance
+BasicGraphAlgorithms<Weight>::BidirectionalDijkstra(const GraphType& graph,
+                                                    int start, int target) {
+  if (start == target) return 0;
+
+  const size_t size = graph.Size();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+
+  using Entry = std::pair<Distance, int>;
+  using Heap =
+      std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>;
+
+  /* side 0 searches from start, side 1 from target over the same lists,
+   * the graph is undirected */
+  std::vector<Distance> distance[2] = {std::vector<Distance>(size, INF),
+                                       std::vector<Distance>(size, INF)};
+  Heap heap[2];
+  distance[0][start] = 0;
+  distance[1][target] = 0;
+  heap[0].push({0, start});
+  heap[1].push({0, target});
+
+  const auto drop_stale = [&](int side) {
+    while (!heap[side].empty() &&
+           heap[side].top().first != distance[side][heap[side].top().second]) {
+      heap[side].pop();
+    }
+  };
+
+  /* length of the best path seen through a vertex reached from both ends */
+  Distance best = INF;
+  while (true) {
+    drop_stale(0);
+    drop_stale(1);
+    if (heap[0].empty() || heap[1].empty()) break;
+    /* no path through unsettled vertices can beat best any more */
+    if (heap[0].top().first + heap[1].top().first >= best) break;
+
+    const int side = heap[0].top().first <= heap[1].top().first ? 0 : 1;
+    const auto [d, v] = heap[side].top();
+    heap[side].pop();
+
+    const auto neighbors = graph.Neighbors(v);
+    const auto weights = graph.NeighborWeights(v);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      const int u = neighbors[e];
+      const Distance candidate = d + weights[e];
+      if (candidate < distance[side][u]) {
+        distance[side][u] = candidate;
+        heap[side].push({candidate, u});
+      }
+      if (distance[1 - side][u] != INF) {
+        best = std::min(best, distance[side][u] + distance[1 - side][u]);
+      }
+    }
   }
-  return (distance[finish] == INF) ? -1 : distance[finish];
+  return best;
 }
 
-std::vector<std::vector<long long>>
-GraphAlgorithms::GetShortestPathsBetweenAllVertices(const Graph& graph) {
+template <typename Weight>
+std::vector<std::vector<typename BasicGraphAlgorithms<Weight>::Distance>>
+BasicGraphAlgorithms<Weight>::GetShortestPathsBetweenAllVertices(
+    const GraphType& graph, unsigned threads, AllPairsMode mode) {
   const size_t size = graph.Size();
 
-  using Distance = long long;
-  const Distance INF = 1e18;
+  const Distance INF = WeightTraits<Weight>::kInfinity;
 
   if (size == 0) {
     return {};
   }
 
-  std::vector<std::vector<Distance>> distance(size,
-                                              std::vector<Distance>(size, INF));
-  const auto& matrix = graph.GetAdjecencyMatrix();
+  if (mode == AllPairsMode::kAuto) {
+    mode = IsSparse(graph) ? AllPairsMode::kRepeatedDijkstra
+                           : AllPairsMode::kFloydWarshall;
+  }
+  const Matrix<Distance> flat = mode == AllPairsMode::kRepeatedDijkstra
+                                    ? RepeatedDijkstra(graph, threads)
+                                    : FloydWarshall(graph, threads);
+  std::vector<std::vector<Distance>> distance(size);
+  for (size_t i = 0; i < size; ++i) {
+    const auto row = flat.Row(i).first(size);
+    distance[i].assign(row.begin(), row.end());
+    /* cleaning up infinities */
+    std::replace(distance[i].begin(), distance[i].end(), INF, Distance{0});
+  }
+  return distance;
+}
 
+template <typename Weight>
+Matrix<typename BasicGraphAlgorithms<Weight>::Distance>
+BasicGraphAlgorithms<Weight>::FloydWarshall(const GraphType& graph,
+                                            unsigned threads) {
+  const size_t size = graph.Size();
+  /* padding vertices are unreachable, so they never shorten a path */
+  const size_t padded = (size + kFloydTile - 1) / kFloydTile * kFloydTile;
+  Matrix<Distance> distance(padded, padded, WeightTraits<Weight>::kInfinity);
   /* initialization of distance matrix */
   for (size_t i = 0; i < size; ++i) {
-    for (size_t j = 0; j < size; ++j) {
-      if (i == j)
-        distance[i][j] = 0;
-      else if (matrix[i][j] > 0)
-        distance[i][j] = matrix[i][j];
+    const auto neighbors = graph.Neighbors(i);
+    const auto weights = graph.NeighborWeights(i);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      distance(i, neighbors[e]) = weights[e];
     }
   }
-  /* Floyd-Warshall algorithm */
-  for (size_t k = 0; k < size; ++k) {
-    for (size_t i = 0; i < size; ++i) {
-      for (size_t j = 0; j < size; ++j) {
-        if (distance[i][k] < INF && distance[k][j] < INF) {
-          distance[i][j] =
-              std::min(distance[i][j], distance[i][k] + distance[k][j]);
+  for (size_t i = 0; i < padded; ++i) distance(i, i) = 0;
+
+  /* Floyd-Warshall algorithm, one tile row of k at a time: the diagonal
+   * tile first, then the tiles sharing its rows and columns, which only
+   * depend on it, then the rest. Tiles of one phase are independent and
+   * dealt round-robin to the workers, a barrier separates the phases, so
+   * every tile sees the same inputs as in a serial run */
+  Distance* d = distance.Data();
+  const size_t stride = distance.Stride();
+  const size_t tiles = padded / kFloydTile;
+  const size_t workers = std::clamp<size_t>(threads, 1, tiles * tiles);
+  std::barrier phase(static_cast<std::ptrdiff_t>(workers));
+
+  ParallelFor(workers, static_cast<unsigned>(workers),
+              [&](unsigned worker, size_t, size_t) {
+                for (size_t k = 0; k < tiles; ++k) {
+                  const size_t k0 = k * kFloydTile;
+                  if (worker == 0) MinPlusTile(d, stride, k0, k0, k0);
+                  phase.arrive_and_wait();
+
+                  for (size_t t = worker; t < tiles; t += workers) {
+                    if (t == k) continue;
+                    MinPlusTile(d, stride, k0, t * kFloydTile, k0);
+                    MinPlusTile(d, stride, t * kFloydTile, k0, k0);
+                  }
+                  phase.arrive_and_wait();
+
+                  for (size_t t = worker; t < tiles * tiles; t += workers) {
+                    const size_t i = t / tiles, j = t % tiles;
+                    if (i == k || j == k) continue;
+                    MinPlusTile(d, stride, i * kFloydTile, j * kFloydTile,
+                                k0);
+                  }
+                  phase.arrive_and_wait();
+                }
+              });
+  return distance;
+}
+
+template <typename Weight>
+SymmetricDistances
+BasicGraphAlgorithms<Weight>::GetCompactShortestPathsBetweenAllVertices(
+    const GraphType& graph, unsigned threads, AllPairsMode mode) {
+  const size_t size = graph.Size();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+  if (size == 0) return {};
+
+  /* unreachable pairs read as 0, like in the full result; Floyd-Warshall
+   * needs the whole padded matrix next to the table, so kAuto always
+   * writes Dijkstra rows straight into it */
+  if (mode != AllPairsMode::kFloydWarshall) {
+    SymmetricDistances table(size, DiameterBound(graph));
+    ParallelFor(size, threads, [&](unsigned, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        const ShortestPathTree tree =
+            HeapDijkstra(graph, static_cast<int>(i), {});
+        for (size_t j = i + 1; j < size; ++j) {
+          if (tree.distance[j] != INF) table.Set(i, j, tree.distance[j]);
         }
       }
+    });
+    return table;
+  }
+
+  const Matrix<Distance> flat = FloydWarshall(graph, threads);
+  Distance longest = 0;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = i + 1; j < size; ++j) {
+      if (flat(i, j) != INF) longest = std::max(longest, flat(i, j));
     }
   }
-  /* cleaning up infinities */
+  SymmetricDistances table(size, longest);
   for (size_t i = 0; i < size; ++i) {
-    for (size_t j = 0; j < size; ++j) {
-      if (distance[i][j] == INF) {
-        distance[i][j] = 0;
+    for (size_t j = i + 1; j < size; ++j) {
+      if (flat(i, j) != INF) table.Set(i, j, flat(i, j));
+    }
+  }
+  return table;
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::Distance
+BasicGraphAlgorithms<Weight>::DiameterBound(const GraphType& graph) {
+  const size_t size = graph.Size();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+  using Entry = std::pair<Distance, int>;
+  std::vector<Distance> distance(size, INF);
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+  /* d(a, b) <= d(a, root) + d(root, b), each search stays inside the
+   * component of its root so all of them together are one Dijkstra */
+  Distance bound = 0;
+  for (size_t root = 0; root < size; ++root) {
+    if (distance[root] != INF) continue;
+    distance[root] = 0;
+    heap.push({0, static_cast<int>(root)});
+    Distance eccentricity = 0;
+    while (!heap.empty()) {
+      const auto [d, v] = heap.top();
+      heap.pop();
+      if (d != distance[v]) continue;
+      eccentricity = d;
+
+      const auto neighbors = graph.Neighbors(v);
+      const auto weights = graph.NeighborWeights(v);
+      for (size_t e = 0; e < neighbors.size(); ++e) {
+        const Distance candidate = d + weights[e];
+        if (candidate < distance[neighbors[e]]) {
+          distance[neighbors[e]] = candidate;
+          heap.push({candidate, neighbors[e]});
+        }
       }
     }
+    bound = std::max(bound, 2 * eccentricity);
   }
-  return distance;
+  return bound;
 }
 
-std::vector<std::vector<long long>> GraphAlgorithms::GetLeastSpanningTree(
-    const Graph& graph) {
+template <typename Weight>
+Matrix<typename BasicGraphAlgorithms<Weight>::Distance>
+BasicGraphAlgorithms<Weight>::RepeatedDijkstra(const GraphType& graph,
+                                               unsigned threads) {
   const size_t size = graph.Size();
+  Matrix<Distance> distance(size, size, WeightTraits<Weight>::kInfinity);
+  /* every row is written by the worker that owns its source */
+  ParallelFor(size, threads, [&](unsigned, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const ShortestPathTree tree =
+          HeapDijkstra(graph, static_cast<int>(i), {});
+      std::copy(tree.distance.begin(), tree.distance.end(),
+                distance.Row(i).begin());
+    }
+  });
+  return distance;
+}
 
-  using Distance = long long;
-  const Distance INF = 1e18;
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::SpanningTree
+BasicGraphAlgorithms<Weight>::GetMinimumSpanningTree(const GraphType& graph,
+                                                     unsigned threads,
+                                                     SpanningTreeMode mode) {
+  if (graph.Size() == 0) {
+    return {};
+  }
 
-  if (size == 0) {
+  if (mode == SpanningTreeMode::kAuto) {
+    mode = IsSparse(graph) ? SpanningTreeMode::kKruskal
+                           : SpanningTreeMode::kDensePrim;
+  }
+  switch (mode) {
+    case SpanningTreeMode::kKruskal:
+      return Kruskal(graph, threads);
+    case SpanningTreeMode::kBoruvka:
+      return Boruvka(graph, threads);
+    case SpanningTreeMode::kHeapPrim:
+      return HeapPrim(graph);
+    default:
+      return DensePrim(graph);
+  }
+}
+
+template <typename Weight>
+std::vector<std::vector<typename BasicGraphAlgorithms<Weight>::Distance>>
+BasicGraphAlgorithms<Weight>::GetLeastSpanningTree(const GraphType& graph,
+                                                   unsigned threads,
+                                                   SpanningTreeMode mode) {
+  const size_t size = graph.Size();
+  const SpanningTree tree = GetMinimumSpanningTree(graph, threads, mode);
+  /* if the graph is empty or disconnected */
+  if (size == 0 || tree.edges.size() + 1 != size) {
     return {};
   }
+  return CreateMSTAdjacencyMatrix(size, tree);
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::SpanningTree
+BasicGraphAlgorithms<Weight>::DensePrim(const GraphType& graph) {
+  const size_t size = graph.Size();
 
-  const auto& matrix = graph.GetAdjecencyMatrix();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
 
   std::vector<bool> visited(size, false);
   std::vector<Distance> dist(size, INF);
@@ -198,28 +1012,210 @@ std::vector<std::vector<long long>> GraphAlgorithms::GetLeastSpanningTree(
 
     visited[v] = true;
 
-    for (size_t u = 0; u < size; ++u) {
-      if (!visited[u] && matrix[v][u] > 0 && matrix[v][u] < dist[u]) {
-        dist[u] = matrix[v][u];
+    const auto neighbors = graph.Neighbors(v);
+    const auto weights = graph.NeighborWeights(v);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      const int u = neighbors[e];
+      if (!visited[u] && weights[e] < dist[u]) {
+        dist[u] = weights[e];
         parent[u] = v;
       }
     }
   }
-  return CreateMSTAdjacencyMatrix(size, matrix, parent);
+  return FromParents(dist, parent);
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::SpanningTree
+BasicGraphAlgorithms<Weight>::HeapPrim(const GraphType& graph) {
+  const size_t size = graph.Size();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+
+  std::vector<bool> visited(size, false);
+  std::vector<Distance> dist(size, INF);
+  std::vector<int> parent(size, -1);
+
+  /* lazy deletion: a vertex may be queued several times, only its first
+   * pop joins the tree */
+  using Entry = std::pair<Distance, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+  dist[0] = 0;
+  heap.push({0, 0});
+
+  size_t joined = 0;
+  while (!heap.empty()) {
+    const int v = heap.top().second;
+    heap.pop();
+    if (visited[v]) continue;
+    visited[v] = true;
+    ++joined;
+
+    const auto neighbors = graph.Neighbors(v);
+    const auto weights = graph.NeighborWeights(v);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      const int u = neighbors[e];
+      if (!visited[u] && weights[e] < dist[u]) {
+        dist[u] = weights[e];
+        parent[u] = v;
+        heap.push({dist[u], u});
+      }
+    }
+  }
+
+  if (joined != size) return {};
+  return FromParents(dist, parent);
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::SpanningTree
+BasicGraphAlgorithms<Weight>::Kruskal(const GraphType& graph,
+                                      unsigned threads) {
+  const size_t size = graph.Size();
+
+  using Candidate = CandidateEdge<Weight>;
+  std::vector<Candidate> edges;
+  edges.reserve(graph.EdgeCount() / 2);
+  for (size_t v = 0; v < size; ++v) {
+    const auto neighbors = graph.Neighbors(v);
+    const auto weights = graph.NeighborWeights(v);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      if (static_cast<size_t>(neighbors[e]) > v) {
+        edges.push_back({weights[e], static_cast<int>(v), neighbors[e]});
+      }
+    }
+  }
+  ParallelSort(edges.begin(), edges.end(), std::less<Candidate>(), threads);
+
+  DisjointSets components(size);
+  SpanningTree tree;
+  tree.edges.reserve(size - 1);
+  for (const Candidate& edge : edges) {
+    if (tree.edges.size() + 1 == size) break;
+    if (components.Unite(edge.from, edge.to)) {
+      tree.edges.push_back({edge.from + 1, edge.to + 1, edge.weight});
+      tree.total_weight += edge.weight;
+    }
+  }
+  if (tree.edges.size() + 1 != size) return {};
+  return tree;
 }
 
-std::vector<std::vector<long long>> GraphAlgorithms::CreateMSTAdjacencyMatrix(
-    size_t size, const std::vector<std::vector<int>>& matrix,
-    const std::vector<int>& parent) {
-  std::vector<std::vector<long long>> mst(size,
-                                          std::vector<long long>(size, 0));
-  for (size_t v = 1; v < size; ++v) {
-    if (parent[v] != -1) {
-      long long w = matrix[v][parent[v]];
-      mst[v][parent[v]] = w;
-      mst[parent[v]][v] = w;
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::SpanningTree
+BasicGraphAlgorithms<Weight>::Boruvka(const GraphType& graph,
+                                      unsigned threads) {
+  const size_t size = graph.Size();
+  const unsigned workers =
+      static_cast<unsigned>(std::clamp<size_t>(threads, 1, size));
+
+  /* the lightest edge leaving a vertex's component, to is -1 for none */
+  using Candidate = CandidateEdge<Weight>;
+
+  std::vector<int> component(size);
+  std::iota(component.begin(), component.end(), 0);
+  std::vector<Candidate> lightest(size);
+  /* the vertex holding the lightest edge of each component, by its root */
+  std::vector<std::atomic<int>> best(size);
+  ConcurrentDisjointSets sets(size);
+  std::vector<std::vector<typename SpanningTree::Edge>> joined(workers);
+
+  size_t components = size;
+  while (components > 1) {
+    ParallelFor(size, workers, [&](unsigned, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        Candidate candidate{0, -1, -1};
+        const auto neighbors = graph.Neighbors(v);
+        const auto weights = graph.NeighborWeights(v);
+        for (size_t e = 0; e < neighbors.size(); ++e) {
+          const int u = neighbors[e];
+          if (component[u] == component[v]) continue;
+          const Candidate edge{weights[e], std::min<int>(u, v),
+                               std::max<int>(u, v)};
+          if (candidate.to == -1 || edge < candidate) {
+            candidate = edge;
+          }
+        }
+        lightest[v] = candidate;
+        best[v].store(-1);
+      }
+    });
+
+    ParallelFor(size, workers, [&](unsigned, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        if (lightest[v].to == -1) continue;
+        std::atomic<int>& slot = best[component[v]];
+        int current = slot.load();
+        while ((current == -1 || lightest[v] < lightest[current]) &&
+               !slot.compare_exchange_weak(current, static_cast<int>(v))) {
+        }
+      }
+    });
+
+    /* an edge picked by both of its components is only joined once */
+    ParallelFor(size, workers, [&](unsigned worker, size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        const int v = best[c].load();
+        if (v == -1) continue;
+        const Candidate& edge = lightest[v];
+        if (sets.Unite(edge.from, edge.to)) {
+          joined[worker].push_back({edge.from + 1, edge.to + 1, edge.weight});
+        }
+      }
+    });
+
+    size_t tree_edges = 0;
+    for (const auto& edges : joined) tree_edges += edges.size();
+    /* the remaining components have no edges between them */
+    if (size - tree_edges == components) break;
+    components = size - tree_edges;
+
+    ParallelFor(size, workers, [&](unsigned, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) component[v] = sets.Find(v);
+    });
+  }
+
+  if (components != 1) return {};
+  SpanningTree tree;
+  tree.edges.reserve(size - 1);
+  for (const auto& edges : joined) {
+    for (const auto& edge : edges) {
+      tree.edges.push_back(edge);
+      tree.total_weight += edge.weight;
     }
   }
+  return tree;
+}
+
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::SpanningTree
+BasicGraphAlgorithms<Weight>::FromParents(const std::vector<Distance>& weight,
+                                          const std::vector<int>& parent) {
+  SpanningTree tree;
+  tree.edges.reserve(parent.size() - 1);
+  for (size_t v = 0; v < parent.size(); ++v) {
+    if (parent[v] == -1) continue;
+    const int from = std::min<int>(parent[v], static_cast<int>(v));
+    const int to = std::max<int>(parent[v], static_cast<int>(v));
+    tree.edges.push_back({from + 1, to + 1, weight[v]});
+    tree.total_weight += weight[v];
+  }
+  return tree;
+}
+
+template <typename Weight>
+std::vector<std::vector<typename BasicGraphAlgorithms<Weight>::Distance>>
+BasicGraphAlgorithms<Weight>::CreateMSTAdjacencyMatrix(
+    size_t size, const SpanningTree& tree) {
+  std::vector<std::vector<Distance>> mst(size, std::vector<Distance>(size, 0));
+  for (const auto& edge : tree.edges) {
+    mst[edge.from - 1][edge.to - 1] = edge.weight;
+    mst[edge.to - 1][edge.from - 1] = edge.weight;
+  }
 
   return mst;
-}
\ No newline at end of file
+}
+
+template class BasicGraphAlgorithms<uint8_t>;
+template class BasicGraphAlgorithms<uint16_t>;
+template class BasicGraphAlgorithms<int>;
+template class BasicGraphAlgorithms<int64_t>;
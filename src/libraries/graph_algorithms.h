@@ -1,28 +1,195 @@
 #ifndef S21_GRAPH_ALGORITHMS_H_
 #define S21_GRAPH_ALGORITHMS_H_
 
+#include <span>
 #include <vector>
 
 #include "graph.h"
+#include "matrix.h"
+#include "parallel.h"
+#include "symmetric_distances.h"
 #include "s21_containers.h"
 
-class GraphAlgorithms {
+/* how GetShortestPathBetweenVertices runs Dijkstra: kDense selects the next
+ * vertex with a linear scan (O(V^2)), kHeap uses a binary heap over the
+ * adjacency lists (O((V + E) log V)), kBidirectional grows heap searches
+ * from both ends until they meet; kAuto picks by density. Shortest path
+ * trees treat kBidirectional as kHeap */
+enum class DijkstraMode { kAuto, kDense, kHeap, kBidirectional };
+
+/* how BreadthFirstSearch expands its frontier: kTopDown follows a FIFO
+ * queue; kDirectionOptimizing keeps the visited set in a bitset and, while
+ * the frontier holds many edges, switches to bottom-up steps in which every
+ * unvisited vertex looks for a parent in a frontier bitset (Beamer's
+ * heuristics), then rebuilds the queue order from the levels. Both return
+ * the same visit order; the second pays off on graphs with few levels and
+ * many edges, on tree-like graphs it never goes bottom-up and is slightly
+ * slower */
+enum class BfsMode { kTopDown, kDirectionOptimizing };
+
+/* how GetShortestPathsBetweenAllVertices runs: blocked Floyd-Warshall
+ * (O(V^3)) or one heap Dijkstra per source (O(V (V + E) log V)) with the
+ * sources spread over threads; kAuto picks Dijkstra for sparse graphs */
+enum class AllPairsMode { kAuto, kFloydWarshall, kRepeatedDijkstra };
+
+/* how GetLeastSpanningTree grows the tree: kDensePrim scans for the closest
+ * vertex (O(V^2)), kHeapPrim keeps a binary heap over the adjacency lists
+ * (O(E log V)), kKruskal sorts the edges across threads and joins them with
+ * union-find (O(E log E)), kBoruvka joins every component to its lightest
+ * neighbor in parallel rounds (O(E log V) work); kAuto picks Kruskal for
+ * sparse graphs. Trees may differ between ties, their total weight does not */
+enum class SpanningTreeMode {
+  kAuto,
+  kDensePrim,
+  kHeapPrim,
+  kKruskal,
+  kBoruvka
+};
+
+/* algorithms over BasicGraph<Weight>, distances are accumulated in
+ * WeightTraits<Weight>::Distance */
+template <typename Weight>
+class BasicGraphAlgorithms {
  public:
-  static std::vector<int> DepthFirstSearch(const Graph& graph,
+  using GraphType = BasicGraph<Weight>;
+  using Distance = typename WeightTraits<Weight>::Distance;
+
+  /* BFS result for one source, indexed by 0-based vertex: hop count or -1
+   * if unreachable, and the 0-based parent or -1 */
+  struct BfsTree {
+    std::vector<int> distance;
+    std::vector<int> parent;
+  };
+
+  /* Dijkstra's result for one source, indexed by 0-based vertex;
+   * predecessor is the 0-based previous vertex on the path or -1,
+   * unreachable vertices keep WeightTraits<Weight>::kInfinity */
+  struct ShortestPathTree {
+    std::vector<Distance> distance;
+    std::vector<int> predecessor;
+  };
+
+  static std::vector<int> DepthFirstSearch(const GraphType& graph,
                                            int start_vertex);
-  static std::vector<int> BreadthFirstSearch(const Graph& graph,
-                                             int start_vertex);
-  static int GetShortestPathBetweenVertices(const Graph& graph, int vertex1,
-                                            int vertex2);
-  static std::vector<std::vector<long long>> GetShortestPathsBetweenAllVertices(
-      const Graph& graph);
-  static std::vector<std::vector<long long>> GetLeastSpanningTree(
-      const Graph& graph);
+  static std::vector<int> BreadthFirstSearch(
+      const GraphType& graph, int start_vertex,
+      BfsMode mode = BfsMode::kTopDown);
+  /* hop counts from the start vertex indexed by 0-based vertex, -1 for
+   * unreachable ones; computed direction-optimizing, without the order */
+  static std::vector<int> GetHopDistances(const GraphType& graph,
+                                          int start_vertex);
+  /* level-synchronous BFS: each frontier is split between the threads,
+   * which claim vertices with an atomic update of a shared visited bitset
+   * and collect their own next frontiers; distances do not depend on the
+   * number of threads, parents are whichever valid one claimed first */
+  static BfsTree GetBfsTree(const GraphType& graph, int start_vertex,
+                            unsigned threads = HardwareThreads());
+  /* row i holds GetHopDistances for sources[i] (1-based); up to 64 sources
+   * share one pass over the adjacency lists, one bit each in per-vertex
+   * masks, batches are spread over threads. An invalid source gives an
+   * empty table */
+  static Matrix<int> GetHopDistanceTable(
+      const GraphType& graph, const std::vector<int>& sources,
+      unsigned threads = HardwareThreads());
+  static int GetShortestPathBetweenVertices(
+      const GraphType& graph, int vertex1, int vertex2,
+      DijkstraMode mode = DijkstraMode::kAuto);
+  /* one run serves every destination; with a target (1-based, 0 for none)
+   * the search stops as soon as the target is settled and only its
+   * distance and path are final */
+  static ShortestPathTree GetShortestPathTree(
+      const GraphType& graph, int source, int target = 0,
+      DijkstraMode mode = DijkstraMode::kAuto);
+  /* 1-based vertices from the source to target, empty if unreachable */
+  static std::vector<int> GetShortestPath(const ShortestPathTree& tree,
+                                          int target);
+  /* one Dijkstra per source, spread over threads, each stops once all
+   * targets are settled: row i holds the distances from sources[i] to
+   * every vertex of targets (1-based), with kInfinity for unreachable
+   * ones; an invalid vertex gives an empty table */
+  static Matrix<Distance> GetDistanceTable(
+      const GraphType& graph, const std::vector<int>& sources,
+      const std::vector<int>& targets, unsigned threads = HardwareThreads());
+  /* the result does not depend on the number of threads or the mode */
+  static std::vector<std::vector<Distance>> GetShortestPathsBetweenAllVertices(
+      const GraphType& graph, unsigned threads = HardwareThreads(),
+      AllPairsMode mode = AllPairsMode::kAuto);
+  /* the same distances in a table holding each pair once; repeated
+   * Dijkstra writes its rows straight into it, sized by a bound on the
+   * diameter, and is what kAuto picks; Floyd-Warshall packs its full
+   * matrix afterwards, so its peak memory exceeds the plain result's */
+  static SymmetricDistances GetCompactShortestPathsBetweenAllVertices(
+      const GraphType& graph, unsigned threads = HardwareThreads(),
+      AllPairsMode mode = AllPairsMode::kAuto);
+  /* minimum spanning tree as V - 1 edges between 1-based vertices, from
+   * the smaller one; no edges for a disconnected graph */
+  struct SpanningTree {
+    struct Edge {
+      int from;
+      int to;
+      Distance weight;
+    };
+    std::vector<Edge> edges;
+    Distance total_weight = 0;
+  };
+
+  static SpanningTree GetMinimumSpanningTree(
+      const GraphType& graph, unsigned threads = HardwareThreads(),
+      SpanningTreeMode mode = SpanningTreeMode::kAuto);
+  /* the same tree as a V x V adjacency matrix, empty if disconnected */
+  static std::vector<std::vector<Distance>> GetLeastSpanningTree(
+      const GraphType& graph, unsigned threads = HardwareThreads(),
+      SpanningTreeMode mode = SpanningTreeMode::kAuto);
 
  private:
-  static std::vector<std::vector<long long>> CreateMSTAdjacencyMatrix(
-      size_t size, const std::vector<std::vector<int>>& matrix,
-      const std::vector<int>& parent);
+  /* hop count from start (0-based) for every vertex, -1 if unreachable */
+  static std::vector<int> DirectionOptimizingLevels(const GraphType& graph,
+                                                    int start);
+  /* hop counts for up to 64 sources written into their table rows */
+  static void MultiSourceBfs(const GraphType& graph, const int* sources,
+                             size_t count, Matrix<int>& table, size_t row);
+  /* the FIFO order within levels: a vertex follows the earliest neighbor
+   * of the previous level, children of one parent ascend */
+  static std::vector<int> VisitOrder(const GraphType& graph, int start,
+                                     const std::vector<int>& level);
+  /* E log V below V^2 */
+  static bool IsSparse(const GraphType& graph);
+  /* 0-based start and targets, the search stops once every target is
+   * settled and no targets run it to completion */
+  static ShortestPathTree RunDijkstra(const GraphType& graph, int start,
+                                      std::span<const int> targets,
+                                      DijkstraMode mode);
+  static ShortestPathTree DenseDijkstra(const GraphType& graph, int start,
+                                        std::span<const int> targets);
+  static ShortestPathTree HeapDijkstra(const GraphType& graph, int start,
+                                       std::span<const int> targets);
+  static Distance BidirectionalDijkstra(const GraphType& graph, int start,
+                                        int target);
+  /* blocked Floyd-Warshall over a flat matrix whose sides are rounded up
+   * to whole tiles, unreachable pairs keep kInfinity */
+  static Matrix<Distance> FloydWarshall(const GraphType& graph,
+                                        unsigned threads);
+  /* at least every finite distance: twice the eccentricity of the first
+   * vertex of each component */
+  static Distance DiameterBound(const GraphType& graph);
+  /* heap Dijkstra from every vertex, size x size with kInfinity */
+  static Matrix<Distance> RepeatedDijkstra(const GraphType& graph,
+                                           unsigned threads);
+  /* the engines return no edges for a disconnected graph */
+  static SpanningTree DensePrim(const GraphType& graph);
+  static SpanningTree HeapPrim(const GraphType& graph);
+  static SpanningTree Kruskal(const GraphType& graph, unsigned threads);
+  static SpanningTree Boruvka(const GraphType& graph, unsigned threads);
+  /* edges from the parent of every vertex but the root */
+  static SpanningTree FromParents(const std::vector<Distance>& weight,
+                                  const std::vector<int>& parent);
+  static std::vector<std::vector<Distance>> CreateMSTAdjacencyMatrix(
+      size_t size, const SpanningTree& tree);
 };
 
-#endif  // S21_GRAPH_ALGORITHMS_H_
\ No newline at end of file
+using GraphAlgorithms = BasicGraphAlgorithms<int>;
+using GraphAlgorithms8 = BasicGraphAlgorithms<uint8_t>;
+using GraphAlgorithms16 = BasicGraphAlgorithms<uint16_t>;
+using GraphAlgorithms64 = BasicGraphAlgorithms<int64_t>;
+
+#endif  // S21_GRAPH_ALGORITHMS_H_
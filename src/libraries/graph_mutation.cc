@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <utility>
+
+#include "graph.h"
+
+template <typename Weight>
+bool BasicGraph<Weight>::AddEdge(int vertex1, int vertex2, Weight weight) {
+  if (!ValidEdge(vertex1, vertex2) || !ValidWeight(weight)) return false;
+
+  const size_t u = static_cast<size_t>(vertex1 - 1);
+  const size_t v = static_cast<size_t>(vertex2 - 1);
+  if (FindEntry(u, vertex2 - 1) != Degree(u)) return false;
+
+  Unpack();
+  InsertEntry(u, vertex2 - 1, weight);
+  if (u != v) InsertEntry(v, vertex1 - 1, weight);
+  SetMatrixWeight(u, v, weight);
+  version_ = NextVersion();
+  return true;
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::RemoveEdge(int vertex1, int vertex2) {
+  if (!ValidEdge(vertex1, vertex2)) return false;
+
+  const size_t u = static_cast<size_t>(vertex1 - 1);
+  const size_t v = static_cast<size_t>(vertex2 - 1);
+  const size_t position = FindEntry(u, vertex2 - 1);
+  if (position == Degree(u)) return false;
+  /* a graph has to keep at least one edge */
+  if (EdgeCount() == (u == v ? 1u : 2u)) return false;
+
+  Unpack();
+  EraseEntry(u, position);
+  if (u != v) EraseEntry(v, FindEntry(v, vertex1 - 1));
+  SetMatrixWeight(u, v, 0);
+  version_ = NextVersion();
+
+  /* moved rows and removals leave holes, reclaim them once they outweigh
+   * the live entries */
+  if (neighbors_.size() > 2 * live_entries_ + Size()) Compact();
+  return true;
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::SetWeight(int vertex1, int vertex2, Weight weight) {
+  if (!ValidEdge(vertex1, vertex2) || !ValidWeight(weight)) return false;
+
+  const size_t u = static_cast<size_t>(vertex1 - 1);
+  const size_t v = static_cast<size_t>(vertex2 - 1);
+  const size_t position = FindEntry(u, vertex2 - 1);
+  if (position == Degree(u)) return false;
+
+  weights_[row_offsets_[u] + position] = weight;
+  weights_[row_offsets_[v] + FindEntry(v, vertex1 - 1)] = weight;
+  SetMatrixWeight(u, v, weight);
+  version_ = NextVersion();
+  return true;
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::ValidEdge(int vertex1, int vertex2) const {
+  const size_t size = Size();
+  return vertex1 >= 1 && vertex2 >= 1 &&
+         static_cast<size_t>(vertex1) <= size &&
+         static_cast<size_t>(vertex2) <= size;
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::ValidWeight(Weight weight) const {
+  return weight > 0 &&
+         DistancesFit(Size(), std::span<const Weight>(&weight, 1));
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::Unpack() {
+  if (!row_degrees_.empty()) return;
+
+  const size_t size = Size();
+  row_degrees_.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    row_degrees_[i] = row_offsets_[i + 1] - row_offsets_[i];
+  }
+  row_capacities_ = row_degrees_;
+  live_entries_ = neighbors_.size();
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::Compact() {
+  if (row_degrees_.empty()) return;
+
+  const size_t size = Size();
+  Buffer<size_t> offsets(size + 1, 0);
+  Buffer<int> neighbors(live_entries_);
+  Buffer<Weight> weights(live_entries_);
+
+  size_t position = 0;
+  for (size_t i = 0; i < size; ++i) {
+    offsets[i] = position;
+    const auto ids = Neighbors(i);
+    const auto values = NeighborWeights(i);
+    std::copy(ids.begin(), ids.end(), neighbors.data() + position);
+    std::copy(values.begin(), values.end(), weights.data() + position);
+    position += ids.size();
+  }
+  offsets[size] = position;
+
+  row_offsets_ = std::move(offsets);
+  neighbors_ = std::move(neighbors);
+  weights_ = std::move(weights);
+  row_degrees_.clear();
+  row_capacities_.clear();
+  live_entries_ = 0;
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::InsertEntry(size_t row, int neighbor, Weight weight) {
+  const size_t degree = row_degrees_[row];
+  size_t begin = row_offsets_[row];
+
+  if (degree == row_capacities_[row]) {
+    /* a full row moves to the end with twice the room */
+    const size_t capacity = std::max<size_t>(4, 2 * degree);
+    const size_t moved = neighbors_.size();
+    neighbors_.resize(moved + capacity);
+    weights_.resize(moved + capacity);
+    std::copy_n(neighbors_.data() + begin, degree, neighbors_.data() + moved);
+    std::copy_n(weights_.data() + begin, degree, weights_.data() + moved);
+    row_offsets_[row] = begin = moved;
+    row_capacities_[row] = capacity;
+  }
+
+  int* ids = neighbors_.data() + begin;
+  Weight* values = weights_.data() + begin;
+  const size_t position = std::lower_bound(ids, ids + degree, neighbor) - ids;
+  std::move_backward(ids + position, ids + degree, ids + degree + 1);
+  std::move_backward(values + position, values + degree, values + degree + 1);
+  ids[position] = neighbor;
+  values[position] = weight;
+
+  ++row_degrees_[row];
+  ++live_entries_;
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::EraseEntry(size_t row, size_t position) {
+  const size_t degree = row_degrees_[row];
+  int* ids = neighbors_.data() + row_offsets_[row];
+  Weight* values = weights_.data() + row_offsets_[row];
+  std::move(ids + position + 1, ids + degree, ids + position);
+  std::move(values + position + 1, values + degree, values + position);
+
+  --row_degrees_[row];
+  --live_entries_;
+}
+
+template <typename Weight>
+size_t BasicGraph<Weight>::FindEntry(size_t row, int neighbor) const {
+  const auto ids = Neighbors(row);
+  const auto it = std::lower_bound(ids.begin(), ids.end(), neighbor);
+  return (it != ids.end() && *it == neighbor)
+             ? static_cast<size_t>(it - ids.begin())
+             : ids.size();
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::SetMatrixWeight(size_t row, size_t col,
+                                         Weight weight) {
+  if (!HasAdjacencyMatrix()) return;
+  adjacency_matrix_(row, col) = weight;
+  adjacency_matrix_(col, row) = weight;
+}
+
+/* the rest of the class is instantiated in graph.cc */
+#define S21_INSTANTIATE_MUTATION(Weight)                                  \
+  template bool BasicGraph<Weight>::AddEdge(int, int, Weight);            \
+  template bool BasicGraph<Weight>::RemoveEdge(int, int);                 \
+  template bool BasicGraph<Weight>::SetWeight(int, int, Weight);          \
+  template bool BasicGraph<Weight>::ValidEdge(int, int) const;            \
+  template bool BasicGraph<Weight>::ValidWeight(Weight) const;            \
+  template void BasicGraph<Weight>::Unpack();                             \
+  template void BasicGraph<Weight>::Compact();                            \
+  template void BasicGraph<Weight>::InsertEntry(size_t, int, Weight);     \
+  template void BasicGraph<Weight>::EraseEntry(size_t, size_t);           \
+  template size_t BasicGraph<Weight>::FindEntry(size_t, int) const;       \
+  template void BasicGraph<Weight>::SetMatrixWeight(size_t, size_t, Weight);
+
+S21_INSTANTIATE_MUTATION(uint8_t)
+S21_INSTANTIATE_MUTATION(uint16_t)
+S21_INSTANTIATE_MUTATION(int)
+S21_INSTANTIATE_MUTATION(int64_t)
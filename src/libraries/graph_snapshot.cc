@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <type_traits>
+
+#include "graph.h"
+#include "mapped_file.h"
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'G', 'R', 'A', 'P', 'H'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint32_t kHasMatrix = 1u << 0;
+/* sections start on a cache line so they can be used in place */
+constexpr uint64_t kSectionAlignment = 64;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t flags;
+  uint32_t weight_size;
+  uint64_t vertices;
+  uint64_t entries;
+  uint64_t stride;
+  uint64_t offsets_at;
+  uint64_t neighbors_at;
+  uint64_t weights_at;
+  uint64_t matrix_at;
+  uint64_t file_size;
+  uint64_t checksum;
+};
+
+static_assert(std::is_trivially_copyable_v<SnapshotHeader>);
+static_assert(sizeof(size_t) == sizeof(uint64_t));
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+
+/* folds a block of bytes into the running hash, four independent lanes of
+ * 64-bit words keep it close to memory bandwidth */
+uint64_t Mix(uint64_t hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  uint64_t lanes[4] = {hash + kPrime1 + kPrime2, hash + kPrime2, hash,
+                       hash - kPrime1};
+
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    for (size_t k = 0; k < 4; ++k) {
+      uint64_t word = 0;
+      std::memcpy(&word, bytes + i + 8 * k, sizeof(word));
+      lanes[k] = std::rotl(lanes[k] + word * kPrime2, 31) * kPrime1;
+    }
+  }
+
+  uint64_t result = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) +
+                    std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+  for (; i < size; ++i) {
+    result = std::rotl(result ^ (bytes[i] * kPrime1), 11) * kPrime2;
+  }
+  return (result ^ size) * kPrime1;
+}
+
+uint64_t Checksum(SnapshotHeader header, const void* offsets,
+                  const void* neighbors, const void* weights,
+                  const void* matrix) {
+  const uint64_t weight_size = header.weight_size;
+  header.checksum = 0;
+  uint64_t hash = Mix(0, &header, sizeof(header));
+  hash = Mix(hash, offsets, (header.vertices + 1) * sizeof(size_t));
+  hash = Mix(hash, neighbors, header.entries * sizeof(int));
+  hash = Mix(hash, weights, header.entries * weight_size);
+  if (header.flags & kHasMatrix) {
+    hash = Mix(hash, matrix, header.vertices * header.stride * weight_size);
+  }
+  return hash;
+}
+
+uint64_t AlignUp(uint64_t position) {
+  return (position + kSectionAlignment - 1) / kSectionAlignment *
+         kSectionAlignment;
+}
+
+/* count elements of the given size starting at position fit in the file */
+bool SectionFits(uint64_t position, uint64_t count, uint64_t element,
+                 uint64_t file_size) {
+  return position % kSectionAlignment == 0 && position <= file_size &&
+         count <= (file_size - position) / element;
+}
+
+/* the checksum only catches accidental damage, the lists of a snapshot
+ * from another writer are checked like the text loaders check theirs:
+ * at least one edge, neighbors in range and strictly ascending, weights
+ * positive, every (v, u, w) matched by (u, v, w); O(E log V) */
+template <typename Weight>
+bool ListsAreValid(const size_t* offsets, const int* neighbors,
+                   const Weight* weights, uint64_t vertices,
+                   uint64_t entries) {
+  /* all offsets first: non-decreasing up to offsets[V] == entries keeps
+   * every row inside the sections before any entry is read */
+  if (entries == 0 || offsets[0] != 0 || offsets[vertices] != entries) {
+    return false;
+  }
+  for (uint64_t v = 0; v < vertices; ++v) {
+    if (offsets[v] > offsets[v + 1]) return false;
+  }
+
+  for (uint64_t v = 0; v < vertices; ++v) {
+    for (size_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+      if (neighbors[e] < 0 || static_cast<uint64_t>(neighbors[e]) >= vertices ||
+          (e > offsets[v] && neighbors[e] <= neighbors[e - 1]) ||
+          weights[e] <= 0) {
+        return false;
+      }
+    }
+  }
+  for (uint64_t v = 0; v < vertices; ++v) {
+    for (size_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+      const int u = neighbors[e];
+      const int* first = neighbors + offsets[u];
+      const int* last = neighbors + offsets[u + 1];
+      const int* twin = std::lower_bound(first, last, static_cast<int>(v));
+      if (twin == last || *twin != static_cast<int>(v) ||
+          weights[twin - neighbors] != weights[e]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/* the dense section has to hold exactly the edges of the lists */
+template <typename Weight>
+bool MatrixMatchesLists(const Weight* matrix, uint64_t stride,
+                        const size_t* offsets, const int* neighbors,
+                        const Weight* weights, uint64_t vertices) {
+  for (uint64_t v = 0; v < vertices; ++v) {
+    const Weight* row = matrix + v * stride;
+    size_t e = offsets[v];
+    for (uint64_t u = 0; u < vertices; ++u) {
+      if (e < offsets[v + 1] && static_cast<uint64_t>(neighbors[e]) == u) {
+        if (row[u] != weights[e++]) return false;
+      } else if (row[u] != 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool WriteSection(std::ofstream& file, const void* data, uint64_t bytes,
+                  uint64_t position) {
+  static const char padding[kSectionAlignment] = {};
+  const uint64_t current = static_cast<uint64_t>(file.tellp());
+  file.write(padding, static_cast<std::streamsize>(position - current));
+  file.write(static_cast<const char*>(data),
+             static_cast<std::streamsize>(bytes));
+  return file.good();
+}
+
+}  // namespace
+
+template <typename Weight>
+bool BasicGraph<Weight>::SaveBinary(const std::string& filename,
+                                    bool with_matrix) const {
+  const size_t size = Size();
+  if (size == 0) return false;
+  if (!row_degrees_.empty()) {
+    BasicGraph<Weight> packed(*this);
+    packed.Compact();
+    return packed.SaveBinary(filename, with_matrix);
+  }
+  with_matrix = with_matrix && HasAdjacencyMatrix();
+
+  SnapshotHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrderMark;
+  header.flags = with_matrix ? kHasMatrix : 0;
+  header.weight_size = sizeof(Weight);
+  header.vertices = size;
+  header.entries = EdgeCount();
+  header.stride = with_matrix ? adjacency_matrix_.Stride() : 0;
+
+  const uint64_t matrix_bytes =
+      header.vertices * header.stride * sizeof(Weight);
+  header.offsets_at = AlignUp(sizeof(header));
+  header.neighbors_at =
+      AlignUp(header.offsets_at + (header.vertices + 1) * sizeof(size_t));
+  header.weights_at =
+      AlignUp(header.neighbors_at + header.entries * sizeof(int));
+  header.matrix_at =
+      AlignUp(header.weights_at + header.entries * sizeof(Weight));
+  header.file_size = header.matrix_at + matrix_bytes;
+
+  const Weight* matrix = with_matrix ? adjacency_matrix_.Data() : nullptr;
+  header.checksum = Checksum(header, row_offsets_.data(), neighbors_.data(),
+                             weights_.data(), matrix);
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) return false;
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  return WriteSection(file, row_offsets_.data(),
+                      (header.vertices + 1) * sizeof(size_t),
+                      header.offsets_at) &&
+         WriteSection(file, neighbors_.data(), header.entries * sizeof(int),
+                      header.neighbors_at) &&
+         WriteSection(file, weights_.data(), header.entries * sizeof(Weight),
+                      header.weights_at) &&
+         WriteSection(file, matrix, matrix_bytes, header.matrix_at);
+}
+
+template <typename Weight>
+bool BasicGraph<Weight>::LoadBinary(const std::string& filename,
+                                    bool verify_checksum) {
+  auto file = std::make_shared<MappedFile>();
+  if (!file->Open(filename) || file->Size() < sizeof(SnapshotHeader)) {
+    return false;
+  }
+
+  SnapshotHeader header{};
+  std::memcpy(&header, file->Data(), sizeof(header));
+
+  const uint64_t file_size = file->Size();
+  const bool with_matrix = (header.flags & kHasMatrix) != 0;
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.byte_order != kByteOrderMark ||
+      header.weight_size != sizeof(Weight) || header.file_size != file_size ||
+      header.vertices == 0 || header.vertices >= file_size) {
+    return false;
+  }
+  if (!SectionFits(header.offsets_at, header.vertices + 1, sizeof(size_t),
+                   file_size) ||
+      !SectionFits(header.neighbors_at, header.entries, sizeof(int),
+                   file_size) ||
+      !SectionFits(header.weights_at, header.entries, sizeof(Weight),
+                   file_size)) {
+    return false;
+  }
+  if (with_matrix &&
+      (header.stride < header.vertices ||
+       header.stride > file_size / header.vertices ||
+       !SectionFits(header.matrix_at, header.vertices * header.stride,
+                    sizeof(Weight), file_size))) {
+    return false;
+  }
+
+  const char* base = file->Data();
+  const auto* offsets =
+      reinterpret_cast<const size_t*>(base + header.offsets_at);
+  const auto* neighbors =
+      reinterpret_cast<const int*>(base + header.neighbors_at);
+  const auto* weights =
+      reinterpret_cast<const Weight*>(base + header.weights_at);
+  const auto* matrix =
+      with_matrix ? reinterpret_cast<const Weight*>(base + header.matrix_at)
+                  : nullptr;
+
+  if (verify_checksum && Checksum(header, offsets, neighbors, weights,
+                                  matrix) != header.checksum) {
+    return false;
+  }
+  if (!ListsAreValid(offsets, neighbors, weights, header.vertices,
+                     header.entries) ||
+      (with_matrix &&
+       !MatrixMatchesLists(matrix, header.stride, offsets, neighbors,
+                           weights, header.vertices))) {
+    return false;
+  }
+  if (!DistancesFit(header.vertices,
+                    std::span<const Weight>(weights, header.entries))) {
+    return false;
+  }
+
+  BasicGraph<Weight> loaded;
+  loaded.row_offsets_ = Buffer<size_t>(file, offsets, header.vertices + 1);
+  loaded.neighbors_ = Buffer<int>(file, neighbors, header.entries);
+  loaded.weights_ = Buffer<Weight>(file, weights, header.entries);
+  loaded.adjacency_matrix_ =
+      with_matrix
+          ? Matrix<Weight>(header.vertices, header.vertices, header.stride,
+                           Buffer<Weight>(file, matrix,
+                                          header.vertices * header.stride))
+          : Matrix<Weight>();
+  Replace(std::move(loaded));
+  return true;
+}
+
+/* the rest of the class is instantiated in graph.cc */
+#define S21_INSTANTIATE_SNAPSHOT(Weight)                                    \
+  template bool BasicGraph<Weight>::SaveBinary(const std::string&, bool) \
+      const;                                                             \
+  template bool BasicGraph<Weight>::LoadBinary(const std::string&, bool);
+
+S21_INSTANTIATE_SNAPSHOT(uint8_t)
+S21_INSTANTIATE_SNAPSHOT(uint16_t)
+S21_INSTANTIATE_SNAPSHOT(int)
+S21_INSTANTIATE_SNAPSHOT(int64_t)
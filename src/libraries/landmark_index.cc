@@ -0,0 +1,184 @@
+#include "landmark_index.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "graph_algorithms.h"
+
+template <typename Weight>
+bool BasicLandmarkIndex<Weight>::Build(const GraphType& graph,
+                                       size_t landmarks) {
+  const size_t size = graph.Size();
+  if (size == 0 || landmarks == 0) return false;
+  landmarks = std::min(landmarks, size);
+
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+  Matrix<Distance> distance(size, landmarks, INF);
+  std::vector<int> chosen;
+
+  /* distance from every vertex to its closest landmark so far, seeded
+   * with vertex 1 so the first landmark is the vertex farthest from it */
+  std::vector<Distance> closest =
+      BasicGraphAlgorithms<Weight>::GetShortestPathTree(graph, 1, 0,
+                                                        DijkstraMode::kHeap)
+          .distance;
+
+  for (size_t l = 0; l < landmarks; ++l) {
+    const int next = static_cast<int>(
+        std::max_element(closest.begin(), closest.end()) - closest.begin());
+    if (closest[next] == 0 && l > 0) break;
+    chosen.push_back(next + 1);
+
+    const auto tree = BasicGraphAlgorithms<Weight>::GetShortestPathTree(
+        graph, next + 1, 0, DijkstraMode::kHeap);
+    for (size_t v = 0; v < size; ++v) {
+      distance(v, l) = tree.distance[v];
+      closest[v] = l == 0 ? tree.distance[v]
+                          : std::min(closest[v], tree.distance[v]);
+    }
+  }
+
+  /* fewer landmarks than asked for when every vertex already is one */
+  if (chosen.size() < landmarks) {
+    Matrix<Distance> trimmed(size, chosen.size(), INF);
+    for (size_t v = 0; v < size; ++v) {
+      std::copy_n(distance.Row(v).begin(), chosen.size(),
+                  trimmed.Row(v).begin());
+    }
+    distance = std::move(trimmed);
+  }
+
+  landmarks_ = std::move(chosen);
+  distance_ = std::move(distance);
+  size_ = size;
+  version_ = graph.Version();
+  return true;
+}
+
+template <typename Weight>
+bool BasicLandmarkIndex<Weight>::IsBuiltFor(const GraphType& graph) const {
+  return size_ != 0 && size_ == graph.Size() && version_ == graph.Version();
+}
+
+template <typename Weight>
+int BasicLandmarkIndex<Weight>::GetShortestPathBetweenVertices(
+    const GraphType& graph, int vertex1, int vertex2) const {
+  thread_local Workspace workspace;
+  return GetShortestPathBetweenVertices(graph, vertex1, vertex2, workspace);
+}
+
+template <typename Weight>
+int BasicLandmarkIndex<Weight>::GetShortestPathBetweenVertices(
+    const GraphType& graph, int vertex1, int vertex2,
+    Workspace& workspace) const {
+  const size_t size = graph.Size();
+  if (size == 0 || vertex1 < 1 || vertex2 < 1 ||
+      static_cast<size_t>(vertex1) > size ||
+      static_cast<size_t>(vertex2) > size) {
+    return -1;
+  }
+  if (!IsBuiltFor(graph)) {
+    return BasicGraphAlgorithms<Weight>::GetShortestPathBetweenVertices(
+        graph, vertex1, vertex2);
+  }
+
+  const Distance distance =
+      Search(graph, vertex1 - 1, vertex2 - 1, workspace);
+  if (distance == WeightTraits<Weight>::kInfinity ||
+      std::cmp_greater(distance, std::numeric_limits<int>::max())) {
+    return -1;
+  }
+  return static_cast<int>(distance);
+}
+
+template <typename Weight>
+const std::vector<int>& BasicLandmarkIndex<Weight>::Landmarks() const {
+  return landmarks_;
+}
+
+template <typename Weight>
+typename BasicLandmarkIndex<Weight>::Distance
+BasicLandmarkIndex<Weight>::LowerBound(size_t vertex,
+                                       const Distance* target) const {
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+  const Distance* row = distance_.Row(vertex).data();
+
+  Distance bound = 0;
+  for (size_t l = 0; l < landmarks_.size(); ++l) {
+    /* a landmark reaching only one of the two proves there is no path */
+    if ((row[l] == INF) != (target[l] == INF)) return INF;
+    if (row[l] != INF) {
+      bound = std::max(bound, row[l] > target[l] ? row[l] - target[l]
+                                                 : target[l] - row[l]);
+    }
+  }
+  return bound;
+}
+
+template <typename Weight>
+typename BasicLandmarkIndex<Weight>::Distance
+BasicLandmarkIndex<Weight>::Search(const GraphType& graph, int start,
+                                   int target, Workspace& workspace) const {
+  const size_t size = graph.Size();
+  const Distance INF = WeightTraits<Weight>::kInfinity;
+  const Distance* target_row = distance_.Row(target).data();
+
+  const Distance start_bound = LowerBound(start, target_row);
+  if (start_bound == INF) return INF;
+
+  /* grows with the largest graph this workspace served */
+  std::vector<Distance>& distance = workspace.distance;
+  std::vector<char>& settled = workspace.settled;
+  std::vector<int>& touched = workspace.touched;
+  if (distance.size() < size) {
+    distance.resize(size, INF);
+    settled.resize(size, 0);
+  }
+
+  /* A* keyed by distance + lower bound, the bounds are consistent so every
+   * vertex is settled once and the target's first pop is final */
+  using Entry = std::pair<Distance, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+  distance[start] = 0;
+  touched.push_back(start);
+  heap.push({start_bound, start});
+
+  Distance result = INF;
+  while (!heap.empty()) {
+    const int v = heap.top().second;
+    heap.pop();
+    if (v == target) {
+      result = distance[v];
+      break;
+    }
+    if (settled[v]) continue;
+    settled[v] = 1;
+
+    const auto neighbors = graph.Neighbors(v);
+    const auto weights = graph.NeighborWeights(v);
+    for (size_t e = 0; e < neighbors.size(); ++e) {
+      const int u = neighbors[e];
+      const Distance candidate = distance[v] + weights[e];
+      if (!settled[u] && candidate < distance[u]) {
+        if (distance[u] == INF) touched.push_back(u);
+        distance[u] = candidate;
+        heap.push({candidate + LowerBound(u, target_row), u});
+      }
+    }
+  }
+
+  for (int v : touched) {
+    distance[v] = INF;
+    settled[v] = 0;
+  }
+  touched.clear();
+  return result;
+}
+
+template class BasicLandmarkIndex<uint8_t>;
+template class BasicLandmarkIndex<uint16_t>;
+template class BasicLandmarkIndex<int>;
+template class BasicLandmarkIndex<int64_t>;
@@ -0,0 +1,60 @@
+#ifndef S21_LANDMARK_INDEX_H_
+#define S21_LANDMARK_INDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+#include "matrix.h"
+
+/* ALT preprocessing: distances from a few landmarks give triangle-inequality
+ * lower bounds |d(L, t) - d(L, v)| that guide an A* search between two
+ * vertices; the index belongs to the graph version it was built from */
+template <typename Weight>
+class BasicLandmarkIndex {
+ public:
+  using GraphType = BasicGraph<Weight>;
+  using Distance = typename WeightTraits<Weight>::Distance;
+
+  /* scratch space of one query: every vertex stays unreached between
+   * queries and only the vertices a search touched are reset, so a query
+   * costs nothing per untouched vertex; one per thread */
+  struct Workspace {
+    std::vector<Distance> distance;
+    std::vector<char> settled;
+    std::vector<int> touched;
+  };
+
+  BasicLandmarkIndex() = default;
+
+  /* farthest-point selection: every next landmark is the vertex farthest
+   * from the ones already chosen, unreached components come first */
+  bool Build(const GraphType& graph, size_t landmarks);
+  bool IsBuiltFor(const GraphType& graph) const;
+
+  /* same contract as GraphAlgorithms::GetShortestPathBetweenVertices, an
+   * index built for another graph version falls back to plain Dijkstra */
+  int GetShortestPathBetweenVertices(const GraphType& graph, int vertex1,
+                                     int vertex2) const;
+  /* the overload above uses a workspace owned by the calling thread */
+  int GetShortestPathBetweenVertices(const GraphType& graph, int vertex1,
+                                     int vertex2, Workspace& workspace) const;
+
+  /* 1-based landmark vertices */
+  const std::vector<int>& Landmarks() const;
+
+ private:
+  Distance LowerBound(size_t vertex, const Distance* target) const;
+  Distance Search(const GraphType& graph, int start, int target,
+                  Workspace& workspace) const;
+
+  std::vector<int> landmarks_;
+  /* one row per vertex holding its distance to every landmark */
+  Matrix<Distance> distance_;
+  size_t size_ = 0;
+  uint64_t version_ = 0;
+};
+
+using LandmarkIndex = BasicLandmarkIndex<int>;
+
+#endif  // S21_LANDMARK_INDEX_H_
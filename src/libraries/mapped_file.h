@@ -0,0 +1,32 @@
+#ifndef S21_MAPPED_FILE_H_
+#define S21_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+/* read-only memory mapping of a whole file, unmapped on destruction */
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  bool Open(const std::string& filename);
+  void Close();
+  /* hints the kernel to read ahead, for one pass parsers */
+  void AdviseSequential() const;
+
+  bool IsOpen() const;
+  const char* Data() const;
+  size_t Size() const;
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+#endif  // S21_MAPPED_FILE_H_
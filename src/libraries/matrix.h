@@ -0,0 +1,65 @@
+#ifndef S21_MATRIX_H_
+#define S21_MATRIX_H_
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include "buffer.h"
+
+/* dense row-major matrix stored in one aligned buffer, every row starts on
+ * a cache line boundary so row scans can be vectorized */
+template <typename T>
+class Matrix {
+ public:
+  static constexpr size_t kAlignment = Buffer<T>::kAlignment;
+
+  Matrix() = default;
+  Matrix(size_t rows, size_t cols, const T& value = T())
+      : rows_(rows),
+        cols_(cols),
+        stride_(PaddedStride(cols)),
+        data_(rows * stride_, value) {}
+  /* wraps rows * stride elements that are already laid out row by row */
+  Matrix(size_t rows, size_t cols, size_t stride, Buffer<T> data)
+      : rows_(rows), cols_(cols), stride_(stride), data_(std::move(data)) {}
+
+  size_t Rows() const { return rows_; }
+  size_t Cols() const { return cols_; }
+  size_t Stride() const { return stride_; }
+  size_t size() const { return rows_; }
+  bool empty() const { return rows_ == 0; }
+
+  T* Data() { return data_.data(); }
+  const T* Data() const { return data_.data(); }
+  const Buffer<T>& Storage() const { return data_; }
+
+  std::span<T> Row(size_t row) {
+    return std::span<T>(data_.data() + row * stride_, cols_);
+  }
+  std::span<const T> Row(size_t row) const {
+    return std::span<const T>(data_.data() + row * stride_, cols_);
+  }
+
+  std::span<T> operator[](size_t row) { return Row(row); }
+  std::span<const T> operator[](size_t row) const { return Row(row); }
+
+  T& operator()(size_t row, size_t col) { return data_[row * stride_ + col]; }
+  const T& operator()(size_t row, size_t col) const {
+    return data_[row * stride_ + col];
+  }
+
+  static size_t PaddedStride(size_t cols) {
+    constexpr size_t per_line =
+        sizeof(T) < kAlignment ? kAlignment / sizeof(T) : 1;
+    return (cols + per_line - 1) / per_line * per_line;
+  }
+
+ private:
+  size_t rows_ = 0;
+  size_t cols_ = 0;
+  size_t stride_ = 0;
+  Buffer<T> data_;
+};
+
+#endif  // S21_MATRIX_H_
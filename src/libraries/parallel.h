@@ -0,0 +1,71 @@
+#ifndef S21_PARALLEL_H_
+#define S21_PARALLEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/* number of workers used when the caller does not ask for a specific one */
+inline unsigned HardwareThreads() {
+  const unsigned threads = std::thread::hardware_concurrency();
+  return threads == 0 ? 1 : threads;
+}
+
+/* splits [0, count) into contiguous chunks and runs
+ * function(worker, begin, end) for every chunk, the calling thread takes the
+ * first one itself */
+template <typename Function>
+void ParallelFor(size_t count, unsigned threads, Function function) {
+  if (count == 0) return;
+  const size_t workers = std::clamp<size_t>(threads, 1, count);
+
+  std::vector<std::thread> pool;
+  pool.reserve(workers - 1);
+  for (size_t w = 1; w < workers; ++w) {
+    pool.emplace_back([&function, w, workers, count] {
+      function(static_cast<unsigned>(w), w * count / workers,
+               (w + 1) * count / workers);
+    });
+  }
+  function(0u, size_t{0}, count / workers);
+
+  for (auto& thread : pool) thread.join();
+}
+
+/* sorts runs of the range in parallel, then merges neighboring runs pairwise,
+ * again in parallel, until one is left; ties keep no particular order, so
+ * callers that need a deterministic result compare on a full key */
+template <typename Iterator, typename Compare>
+void ParallelSort(Iterator first, Iterator last, Compare compare,
+                  unsigned threads) {
+  const size_t count = static_cast<size_t>(last - first);
+  const size_t runs = std::clamp<size_t>(threads, 1, count == 0 ? 1 : count);
+  if (runs == 1) {
+    std::sort(first, last, compare);
+    return;
+  }
+
+  std::vector<size_t> bounds(runs + 1);
+  for (size_t r = 0; r <= runs; ++r) bounds[r] = r * count / runs;
+  ParallelFor(runs, threads, [&](unsigned, size_t begin, size_t end) {
+    for (size_t r = begin; r < end; ++r) {
+      std::sort(first + bounds[r], first + bounds[r + 1], compare);
+    }
+  });
+
+  for (size_t width = 1; width < runs; width *= 2) {
+    const size_t merges = (runs + 2 * width - 1) / (2 * width);
+    ParallelFor(merges, threads, [&](unsigned, size_t begin, size_t end) {
+      for (size_t m = begin; m < end; ++m) {
+        const size_t left = 2 * width * m;
+        const size_t middle = std::min(left + width, runs);
+        const size_t right = std::min(left + 2 * width, runs);
+        std::inplace_merge(first + bounds[left], first + bounds[middle],
+                           first + bounds[right], compare);
+      }
+    });
+  }
+}
+
+#endif  // S21_PARALLEL_H_
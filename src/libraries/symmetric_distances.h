@@ -0,0 +1,77 @@
+#ifndef S21_SYMMETRIC_DISTANCES_H_
+#define S21_SYMMETRIC_DISTANCES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "buffer.h"
+
+/* all-pairs distances of an undirected graph: only pairs i < j are stored,
+ * row by row, each in the narrowest unsigned type holding the largest
+ * distance the table was created for; the diagonal reads as 0 */
+class SymmetricDistances {
+ public:
+  SymmetricDistances() = default;
+  SymmetricDistances(size_t size, unsigned long long max_distance)
+      : size_(size) {
+    const size_t pairs = size * (size - (size > 0)) / 2;
+    if (max_distance <= UINT8_MAX) {
+      data_ = Buffer<uint8_t>(pairs);
+    } else if (max_distance <= UINT16_MAX) {
+      data_ = Buffer<uint16_t>(pairs);
+    } else if (max_distance <= UINT32_MAX) {
+      data_ = Buffer<uint32_t>(pairs);
+    } else {
+      data_ = Buffer<uint64_t>(pairs);
+    }
+  }
+
+  size_t Size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  /* bytes per stored distance */
+  size_t Width() const {
+    return std::visit([](const auto& data) { return sizeof(data[0]); }, data_);
+  }
+
+  long long operator()(size_t i, size_t j) const {
+    if (i == j) return 0;
+    const size_t index = Index(i, j);
+    switch (data_.index()) {
+      case 0:
+        return std::get<0>(data_)[index];
+      case 1:
+        return std::get<1>(data_)[index];
+      case 2:
+        return std::get<2>(data_)[index];
+      default:
+        return static_cast<long long>(std::get<3>(data_)[index]);
+    }
+  }
+
+  /* rows may be filled from several threads, every pair is its own element */
+  void Set(size_t i, size_t j, unsigned long long distance) {
+    if (i == j) return;
+    std::visit(
+        [index = Index(i, j), distance](auto& data) {
+          using Value = std::remove_reference_t<decltype(data[0])>;
+          data.data()[index] = static_cast<Value>(distance);
+        },
+        data_);
+  }
+
+ private:
+  size_t Index(size_t i, size_t j) const {
+    if (i > j) std::swap(i, j);
+    return i * size_ - i * (i + 1) / 2 + (j - i - 1);
+  }
+
+  size_t size_ = 0;
+  std::variant<Buffer<uint8_t>, Buffer<uint16_t>, Buffer<uint32_t>,
+               Buffer<uint64_t>>
+      data_;
+};
+
+#endif  // S21_SYMMETRIC_DISTANCES_H_
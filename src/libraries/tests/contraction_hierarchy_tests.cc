@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+
+#include "contraction_hierarchy.h"
+#include "graph.h"
+#include "graph_algorithms.h"
+
+TEST(ContractionHierarchy, BuildFail) {
+  Graph graph;
+  ContractionHierarchy hierarchy;
+  EXPECT_FALSE(hierarchy.Build(graph));
+  EXPECT_FALSE(hierarchy.SaveBinary("libraries/tests/output/empty.ch"));
+  EXPECT_EQ(hierarchy.GetShortestPathBetweenVertices(1, 2), -1);
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  ASSERT_TRUE(hierarchy.Build(graph));
+  EXPECT_EQ(hierarchy.Size(), graph.Size());
+  EXPECT_EQ(hierarchy.GetShortestPathBetweenVertices(0, 2), -1);
+  EXPECT_EQ(hierarchy.GetShortestPathBetweenVertices(1, 6), -1);
+}
+
+TEST(ContractionHierarchy, MatchesDijkstraOnSmallGraph) {
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromFile(
+      "libraries/tests/data/travelling_salesman_problem_graph.txt"));
+  ContractionHierarchy hierarchy;
+  ASSERT_TRUE(hierarchy.Build(graph));
+
+  const int size = static_cast<int>(graph.Size());
+  for (int from = 1; from <= size; ++from) {
+    for (int to = 1; to <= size; ++to) {
+      EXPECT_EQ(hierarchy.GetShortestPathBetweenVertices(from, to),
+                GraphAlgorithms::GetShortestPathBetweenVertices(graph, from,
+                                                                to));
+    }
+  }
+}
+
+TEST(ContractionHierarchy, MatchesDijkstraOnGrid) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  ContractionHierarchy hierarchy;
+  ASSERT_TRUE(hierarchy.Build(graph));
+  EXPECT_GT(hierarchy.ShortcutCount(), 0u);
+
+  const int size = static_cast<int>(graph.Size());
+  for (int from = 1; from <= size; from += 29) {
+    const auto tree = GraphAlgorithms::GetShortestPathTree(graph, from);
+    for (int to = 1; to <= size; to += 7) {
+      EXPECT_EQ(hierarchy.GetShortestPathBetweenVertices(from, to),
+                tree.distance[to - 1]);
+    }
+  }
+}
+
+TEST(ContractionHierarchy, Disconnected) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  ContractionHierarchy hierarchy;
+  ASSERT_TRUE(hierarchy.Build(graph));
+  EXPECT_EQ(hierarchy.GetShortestPathBetweenVertices(1, 3), -1);
+  EXPECT_EQ(hierarchy.GetShortestPathBetweenVertices(3, 2), 5);
+  EXPECT_EQ(hierarchy.GetShortestPathBetweenVertices(4, 4), 0);
+}
+
+TEST(ContractionHierarchy, SaveAndLoad) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  ContractionHierarchy built;
+  ASSERT_TRUE(built.Build(graph));
+  ASSERT_TRUE(built.SaveBinary("libraries/tests/output/grid.ch"));
+
+  ContractionHierarchy loaded;
+  ASSERT_TRUE(loaded.LoadBinary("libraries/tests/output/grid.ch"));
+  EXPECT_EQ(loaded.Size(), built.Size());
+  EXPECT_EQ(loaded.ShortcutCount(), built.ShortcutCount());
+  for (int from = 1; from <= 900; from += 97) {
+    for (int to = 1; to <= 900; to += 31) {
+      EXPECT_EQ(loaded.GetShortestPathBetweenVertices(from, to),
+                built.GetShortestPathBetweenVertices(from, to));
+    }
+  }
+
+  /* narrower distances, a truncated file and a missing one are refused */
+  BasicContractionHierarchy<uint8_t> narrow;
+  EXPECT_FALSE(narrow.LoadBinary("libraries/tests/output/grid.ch"));
+
+  std::ifstream source("libraries/tests/output/grid.ch", std::ios::binary);
+  std::string bytes((std::istreambuf_iterator<char>(source)),
+                    std::istreambuf_iterator<char>());
+  std::ofstream("libraries/tests/output/truncated.ch", std::ios::binary)
+      << bytes.substr(0, bytes.size() - 1);
+  EXPECT_FALSE(loaded.LoadBinary("libraries/tests/output/truncated.ch"));
+  EXPECT_FALSE(loaded.LoadBinary("libraries/tests/output/missing.ch"));
+  EXPECT_EQ(loaded.Size(), built.Size());
+}
+
+TEST(ContractionHierarchy, OffsetPastArcsFails) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  ContractionHierarchy built;
+  ASSERT_TRUE(built.Build(graph));
+  const std::string path = "libraries/tests/output/offset.ch";
+  ASSERT_TRUE(built.SaveBinary(path));
+
+  std::ifstream source(path, std::ios::binary);
+  std::string bytes((std::istreambuf_iterator<char>(source)),
+                    std::istreambuf_iterator<char>());
+  source.close();
+
+  /* a 48 byte header with the vertex count at byte 24, then the ranks and
+   * the offsets; the last row starts past the arcs, the others are valid */
+  uint64_t vertices = 0;
+  std::memcpy(&vertices, bytes.data() + 24, sizeof(vertices));
+  const size_t last_row = 48 + vertices * sizeof(int) +
+                          (vertices - 1) * sizeof(size_t);
+  const size_t past = size_t{1} << 40;
+  std::memcpy(bytes.data() + last_row, &past, sizeof(past));
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+
+  ContractionHierarchy loaded;
+  EXPECT_FALSE(loaded.LoadBinary(path));
+  EXPECT_EQ(loaded.Size(), 0u);
+}
+
+TEST(ContractionHierarchy, ConcurrentQueries) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  ContractionHierarchy hierarchy;
+  ASSERT_TRUE(hierarchy.Build(graph));
+  const auto tree = GraphAlgorithms::GetShortestPathTree(graph, 5);
+
+  /* a const hierarchy is shared, every thread has its own workspace */
+  const ContractionHierarchy& shared = hierarchy;
+  const int size = static_cast<int>(graph.Size());
+  std::vector<int> mismatches(4, 0);
+  ParallelFor(4, 4, [&](unsigned worker, size_t, size_t) {
+    ContractionHierarchy::Workspace workspace;
+    for (int round = 0; round < 3; ++round) {
+      for (int to = 1 + static_cast<int>(worker); to <= size; to += 5) {
+        const int expected = tree.distance[to - 1];
+        if (shared.GetShortestPathBetweenVertices(5, to) != expected ||
+            shared.GetShortestPathBetweenVertices(5, to, workspace) !=
+                expected) {
+          ++mismatches[worker];
+        }
+      }
+    }
+  });
+  EXPECT_EQ(mismatches, std::vector<int>(4, 0));
+}
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <tuple>
 
 #include "graph.h"
 #include "graph_algorithms.h"
@@ -60,6 +62,112 @@ TEST(AlgorithmsTests, BFSSimpleTest5) {
   EXPECT_EQ(GraphAlgorithms::BreadthFirstSearch(graph, start_vertex), check);
 }
 
+TEST(AlgorithmsTests, DirectionOptimizingBFSKeepsOrder) {
+  for (const char* file : {"libraries/tests/data/grid_edge_list.txt",
+                           "libraries/tests/data/sparse_edge_list.txt",
+                           "libraries/tests/data/edge_list_graph.txt"}) {
+    Graph graph;
+    ASSERT_TRUE(graph.LoadGraphFromEdgeList(file));
+    const int size = static_cast<int>(graph.Size());
+    for (int start = 1; start <= size; start += 1 + size / 16) {
+      EXPECT_EQ(GraphAlgorithms::BreadthFirstSearch(
+                    graph, start, BfsMode::kDirectionOptimizing),
+                GraphAlgorithms::BreadthFirstSearch(graph, start));
+    }
+  }
+
+  /* a nearly complete graph switches to bottom-up right away */
+  Graph dense;
+  ASSERT_TRUE(dense.LoadGraphFromFile(
+      "libraries/tests/data/travelling_salesman_problem_graph.txt"));
+  for (int start = 1; start <= static_cast<int>(dense.Size()); ++start) {
+    EXPECT_EQ(GraphAlgorithms::BreadthFirstSearch(
+                  dense, start, BfsMode::kDirectionOptimizing),
+              GraphAlgorithms::BreadthFirstSearch(dense, start));
+  }
+  EXPECT_TRUE(GraphAlgorithms::BreadthFirstSearch(
+                  dense, 0, BfsMode::kDirectionOptimizing)
+                  .empty());
+}
+
+TEST(AlgorithmsTests, HopDistances) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  for (int start : {1, 15, 465, 900}) {
+    std::vector<int> hops(graph.Size(), -1);
+    std::vector<int> queue = {start - 1};
+    hops[start - 1] = 0;
+    for (size_t i = 0; i < queue.size(); ++i) {
+      for (int u : graph.Neighbors(queue[i])) {
+        if (hops[u] != -1) continue;
+        hops[u] = hops[queue[i]] + 1;
+        queue.push_back(u);
+      }
+    }
+    EXPECT_EQ(GraphAlgorithms::GetHopDistances(graph, start), hops);
+  }
+
+  Graph disconnected;
+  ASSERT_TRUE(
+      disconnected.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  EXPECT_EQ(GraphAlgorithms::GetHopDistances(disconnected, 2),
+            std::vector<int>({-1, 0, 1, -1}));
+  EXPECT_TRUE(GraphAlgorithms::GetHopDistances(disconnected, 5).empty());
+}
+
+TEST(AlgorithmsTests, ParallelBfsTree) {
+  for (const char* file : {"libraries/tests/data/grid_edge_list.txt",
+                           "libraries/tests/data/sparse_edge_list.txt"}) {
+    Graph graph;
+    ASSERT_TRUE(graph.LoadGraphFromEdgeList(file));
+    for (int start : {1, 40, 68}) {
+      const auto hops = GraphAlgorithms::GetHopDistances(graph, start);
+      for (unsigned threads : {1u, 3u, 8u}) {
+        const auto tree = GraphAlgorithms::GetBfsTree(graph, start, threads);
+        EXPECT_EQ(tree.distance, hops);
+        ASSERT_EQ(tree.parent.size(), graph.Size());
+        EXPECT_EQ(tree.parent[start - 1], -1);
+        /* any parent one hop closer along an edge is a valid one */
+        for (size_t v = 0; v < graph.Size(); ++v) {
+          const int parent = tree.parent[v];
+          if (parent == -1) continue;
+          const auto neighbors = graph.Neighbors(v);
+          EXPECT_TRUE(std::binary_search(neighbors.begin(), neighbors.end(),
+                                         parent));
+          EXPECT_EQ(tree.distance[parent] + 1, tree.distance[v]);
+        }
+      }
+    }
+  }
+
+  Graph graph;
+  EXPECT_TRUE(GraphAlgorithms::GetBfsTree(graph, 1).distance.empty());
+}
+
+TEST(AlgorithmsTests, HopDistanceTable) {
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/sparse_edge_list.txt"));
+  /* 70 sources plus a repeated one make two batches */
+  std::vector<int> sources;
+  for (int v = 1; v <= 70; ++v) sources.push_back(v);
+  sources.push_back(69);
+
+  for (unsigned threads : {1u, 2u}) {
+    const auto table =
+        GraphAlgorithms::GetHopDistanceTable(graph, sources, threads);
+    ASSERT_EQ(table.Rows(), sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+      const auto row = table.Row(i);
+      EXPECT_EQ(std::vector<int>(row.begin(), row.end()),
+                GraphAlgorithms::GetHopDistances(graph, sources[i]));
+    }
+  }
+  EXPECT_TRUE(GraphAlgorithms::GetHopDistanceTable(graph, {1, 71}).empty());
+  EXPECT_TRUE(GraphAlgorithms::GetHopDistanceTable(graph, {}).empty());
+}
+
 TEST(AlgorithmsTests, DFSFailTest1) {
   Graph graph;
   EXPECT_EQ(GraphAlgorithms::DepthFirstSearch(graph, 4), std::vector<int>());
@@ -176,6 +284,185 @@ TEST(AlgorithmsTests, DijkstrasTest3) {
             check);
 }
 
+TEST(AlgorithmsTests, DijkstraModesAgree) {
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromFile(
+      "libraries/tests/data/travelling_salesman_problem_graph.txt"));
+  const int size = static_cast<int>(graph.Size());
+  for (int from = 1; from <= size; ++from) {
+    for (int to = 1; to <= size; ++to) {
+      const int dense = GraphAlgorithms::GetShortestPathBetweenVertices(
+          graph, from, to, DijkstraMode::kDense);
+      EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                    graph, from, to, DijkstraMode::kHeap),
+                dense);
+      EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                    graph, from, to, DijkstraMode::kBidirectional),
+                dense);
+      EXPECT_EQ(
+          GraphAlgorithms::GetShortestPathBetweenVertices(graph, from, to),
+          dense);
+    }
+  }
+}
+
+TEST(AlgorithmsTests, HeapDijkstraDisconnected) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                graph, 2, 3, DijkstraMode::kHeap),
+            5);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                graph, 1, 3, DijkstraMode::kHeap),
+            -1);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                graph, 1, 3, DijkstraMode::kBidirectional),
+            -1);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                graph, 3, 2, DijkstraMode::kBidirectional),
+            5);
+  Graph overflow;
+  ASSERT_TRUE(
+      overflow.LoadGraphFromFile("libraries/tests/data/overflow_graph.txt"));
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                overflow, 1, 3, DijkstraMode::kHeap),
+            -1);
+}
+
+TEST(AlgorithmsTests, ShortestPathTreeMatchesFloydWarshall) {
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromFile(
+      "libraries/tests/data/travelling_salesman_problem_graph.txt"));
+  const auto all = GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  const int size = static_cast<int>(graph.Size());
+
+  for (DijkstraMode mode : {DijkstraMode::kDense, DijkstraMode::kHeap}) {
+    for (int source = 1; source <= size; ++source) {
+      const auto tree =
+          GraphAlgorithms::GetShortestPathTree(graph, source, 0, mode);
+      ASSERT_EQ(tree.distance.size(), graph.Size());
+      EXPECT_EQ(tree.distance, all[source - 1]);
+      EXPECT_EQ(tree.predecessor[source - 1], -1);
+
+      for (int target = 1; target <= size; ++target) {
+        const auto path = GraphAlgorithms::GetShortestPath(tree, target);
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), source);
+        EXPECT_EQ(path.back(), target);
+        long long length = 0;
+        for (size_t k = 1; k < path.size(); ++k) {
+          length += graph.GetAdjecencyMatrix()(path[k - 1] - 1, path[k] - 1);
+        }
+        EXPECT_EQ(length, all[source - 1][target - 1]);
+      }
+    }
+  }
+}
+
+TEST(AlgorithmsTests, ShortestPathTreeEarlyExit) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  for (DijkstraMode mode : {DijkstraMode::kDense, DijkstraMode::kHeap}) {
+    const auto tree = GraphAlgorithms::GetShortestPathTree(graph, 5, 1, mode);
+    EXPECT_EQ(tree.distance[0], 2);
+    EXPECT_EQ(GraphAlgorithms::GetShortestPath(tree, 1),
+              std::vector<int>({5, 2, 1}));
+  }
+  EXPECT_TRUE(GraphAlgorithms::GetShortestPathTree(graph, 0).distance.empty());
+  EXPECT_TRUE(
+      GraphAlgorithms::GetShortestPathTree(graph, 1, 6).distance.empty());
+
+  Graph disconnected;
+  ASSERT_TRUE(
+      disconnected.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  const auto tree = GraphAlgorithms::GetShortestPathTree(disconnected, 2);
+  EXPECT_TRUE(GraphAlgorithms::GetShortestPath(tree, 1).empty());
+  EXPECT_EQ(GraphAlgorithms::GetShortestPath(tree, 3),
+            std::vector<int>({2, 3}));
+}
+
+TEST(AlgorithmsTests, BidirectionalDijkstraOnSparseGrid) {
+  /* 30 x 30 grid, sparse enough for kAuto to pick the bidirectional search */
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+
+  const int size = static_cast<int>(graph.Size());
+  for (int from = 1; from <= size; from += 37) {
+    const auto tree = GraphAlgorithms::GetShortestPathTree(graph, from);
+    for (int to = 1; to <= size; to += 11) {
+      EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                    graph, from, to, DijkstraMode::kBidirectional),
+                tree.distance[to - 1]);
+      EXPECT_EQ(
+          GraphAlgorithms::GetShortestPathBetweenVertices(graph, from, to),
+          tree.distance[to - 1]);
+    }
+  }
+}
+
+TEST(AlgorithmsTests, DistanceTable) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  const std::vector<int> sources = {1, 45, 450, 900, 45};
+  const std::vector<int> targets = {900, 1, 2, 31, 451, 600, 899};
+
+  for (unsigned threads : {1u, 3u}) {
+    const auto table =
+        GraphAlgorithms::GetDistanceTable(graph, sources, targets, threads);
+    ASSERT_EQ(table.Rows(), sources.size());
+    ASSERT_EQ(table.Cols(), targets.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+      const auto tree = GraphAlgorithms::GetShortestPathTree(graph, sources[i]);
+      for (size_t j = 0; j < targets.size(); ++j) {
+        EXPECT_EQ(table(i, j), tree.distance[targets[j] - 1]);
+      }
+    }
+  }
+}
+
+TEST(AlgorithmsTests, DistanceTableStopsAtTargets) {
+  /* repeated targets, a source among them, and a dense graph searched by
+   * the linear scan */
+  Graph grid;
+  ASSERT_TRUE(
+      grid.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  const auto near = GraphAlgorithms::GetDistanceTable(grid, {1, 32},
+                                                      {2, 31, 2, 32, 1});
+  const auto tree = GraphAlgorithms::GetShortestPathTree(grid, 32);
+  EXPECT_EQ(near(0, 0), near(0, 2));
+  EXPECT_EQ(near(1, 3), 0);
+  EXPECT_EQ(near(1, 4), tree.distance[0]);
+  EXPECT_EQ(near(1, 0), tree.distance[1]);
+
+  Graph dense;
+  ASSERT_TRUE(
+      dense.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  const auto all = GraphAlgorithms::GetShortestPathsBetweenAllVertices(dense);
+  const auto table = GraphAlgorithms::GetDistanceTable(dense, {1, 3}, {2, 5});
+  EXPECT_EQ(table(0, 0), all[0][1]);
+  EXPECT_EQ(table(0, 1), all[0][4]);
+  EXPECT_EQ(table(1, 0), all[2][1]);
+  EXPECT_EQ(table(1, 1), all[2][4]);
+}
+
+TEST(AlgorithmsTests, DistanceTableFail) {
+  Graph graph;
+  EXPECT_TRUE(GraphAlgorithms::GetDistanceTable(graph, {1}, {1}).empty());
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  EXPECT_TRUE(GraphAlgorithms::GetDistanceTable(graph, {1, 5}, {1}).empty());
+  EXPECT_TRUE(GraphAlgorithms::GetDistanceTable(graph, {1}, {0}).empty());
+
+  const auto table = GraphAlgorithms::GetDistanceTable(graph, {2}, {1, 3});
+  ASSERT_EQ(table.Rows(), 1u);
+  EXPECT_EQ(table(0, 0), WeightTraits<int>::kInfinity);
+  EXPECT_EQ(table(0, 1), 5);
+}
+
 TEST(AlgorithmsTests, FloydWarshallTest1) {
   Graph graph;
   ASSERT_TRUE(
@@ -188,6 +475,123 @@ TEST(AlgorithmsTests, FloydWarshallTest1) {
   EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph), check);
 }
 
+TEST(AlgorithmsTests, FloydWarshallAcrossTiles) {
+  /* 70 vertices span a partial tile, 68..70 form their own component */
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/sparse_edge_list.txt"));
+  const auto all = GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  const int size = static_cast<int>(graph.Size());
+  ASSERT_EQ(all.size(), graph.Size());
+
+  for (int source = 1; source <= size; ++source) {
+    auto expected =
+        GraphAlgorithms::GetShortestPathTree(graph, source).distance;
+    std::replace(expected.begin(), expected.end(),
+                 WeightTraits<int>::kInfinity, 0LL);
+    EXPECT_EQ(all[source - 1], expected);
+  }
+  EXPECT_EQ(all[0][69], 0);
+  EXPECT_EQ(all[67][69], 10);
+}
+
+TEST(AlgorithmsTests, FloydWarshallThreads) {
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/sparse_edge_list.txt"));
+  const auto serial =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph, 1);
+  for (unsigned threads : {0u, 2u, 4u, 16u}) {
+    EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph,
+                                                                  threads),
+              serial);
+  }
+}
+
+TEST(AlgorithmsTests, AllPairsRepeatedDijkstra) {
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/sparse_edge_list.txt"));
+  const auto floyd = GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+      graph, 1, AllPairsMode::kFloydWarshall);
+  for (unsigned threads : {1u, 3u}) {
+    EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+                  graph, threads, AllPairsMode::kRepeatedDijkstra),
+              floyd);
+  }
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph), floyd);
+
+  Graph dense;
+  ASSERT_TRUE(
+      dense.LoadGraphFromFile("libraries/tests/data/fw_overflow.txt"));
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+                dense, 2, AllPairsMode::kRepeatedDijkstra),
+            GraphAlgorithms::GetShortestPathsBetweenAllVertices(dense));
+}
+
+TEST(AlgorithmsTests, CompactAllPairs) {
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/sparse_edge_list.txt"));
+  const auto full = GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  long long longest = 0;
+  for (const auto& row : full) {
+    longest = std::max(longest, *std::max_element(row.begin(), row.end()));
+  }
+
+  for (AllPairsMode mode :
+       {AllPairsMode::kFloydWarshall, AllPairsMode::kRepeatedDijkstra,
+        AllPairsMode::kAuto}) {
+    const auto compact =
+        GraphAlgorithms::GetCompactShortestPathsBetweenAllVertices(graph, 2,
+                                                                   mode);
+    ASSERT_EQ(compact.Size(), graph.Size());
+    for (size_t i = 0; i < graph.Size(); ++i) {
+      for (size_t j = 0; j < graph.Size(); ++j) {
+        EXPECT_EQ(compact(i, j), full[i][j]);
+      }
+    }
+    if (mode == AllPairsMode::kFloydWarshall) {
+      EXPECT_EQ(compact.Width(), longest <= UINT8_MAX ? 1u : 2u);
+    }
+  }
+
+  /* dense graphs too: kAuto never builds the full Floyd-Warshall matrix */
+  Graph dense;
+  ASSERT_TRUE(
+      dense.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  const auto dense_full =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(dense);
+  const auto dense_compact =
+      GraphAlgorithms::GetCompactShortestPathsBetweenAllVertices(dense);
+  for (size_t i = 0; i < dense.Size(); ++i) {
+    for (size_t j = 0; j < dense.Size(); ++j) {
+      EXPECT_EQ(dense_compact(i, j), dense_full[i][j]);
+    }
+  }
+
+  Graph empty;
+  EXPECT_TRUE(GraphAlgorithms::GetCompactShortestPathsBetweenAllVertices(empty)
+                  .empty());
+}
+
+TEST(AlgorithmsTests, SymmetricDistancesWidth) {
+  SymmetricDistances narrow(4, 255);
+  EXPECT_EQ(narrow.Width(), 1u);
+  narrow.Set(3, 1, 200);
+  EXPECT_EQ(narrow(1, 3), 200);
+  EXPECT_EQ(narrow(3, 1), 200);
+  EXPECT_EQ(narrow(2, 2), 0);
+  EXPECT_EQ(SymmetricDistances(4, 256).Width(), 2u);
+  EXPECT_EQ(SymmetricDistances(4, 70000).Width(), 4u);
+
+  SymmetricDistances wide(3, 5000000000ULL);
+  EXPECT_EQ(wide.Width(), 8u);
+  wide.Set(0, 2, 5000000000ULL);
+  EXPECT_EQ(wide(2, 0), 5000000000LL);
+  EXPECT_EQ(wide(0, 1), 0);
+}
+
 TEST(AlgorithmsTests, FloydWarshallOverflow) {
   Graph graph;
   ASSERT_TRUE(graph.LoadGraphFromFile("libraries/tests/data/fw_overflow.txt"));
@@ -229,4 +633,127 @@ TEST(AlgorithmsTests, PrimmEmptyGraph) {
   auto mst = GraphAlgorithms::GetLeastSpanningTree(graph);
   std::vector<std::vector<long long>> expected;
   EXPECT_EQ(mst, expected);
-}
\ No newline at end of file
+}
+
+TEST(AlgorithmsTests, MinimumSpanningTreeEdges) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  const auto tree = GraphAlgorithms::GetMinimumSpanningTree(graph);
+  ASSERT_EQ(tree.edges.size(), 4u);
+  EXPECT_EQ(tree.total_weight, 5);
+
+  std::vector<std::tuple<int, int, long long>> edges;
+  for (const auto& edge : tree.edges) {
+    edges.emplace_back(edge.from, edge.to, edge.weight);
+  }
+  std::sort(edges.begin(), edges.end());
+  const std::vector<std::tuple<int, int, long long>> check = {
+      {1, 2, 1}, {1, 3, 2}, {2, 5, 1}, {4, 5, 1}};
+  EXPECT_EQ(edges, check);
+
+  for (SpanningTreeMode mode :
+       {SpanningTreeMode::kDensePrim, SpanningTreeMode::kHeapPrim,
+        SpanningTreeMode::kKruskal, SpanningTreeMode::kBoruvka}) {
+    EXPECT_EQ(GraphAlgorithms::GetMinimumSpanningTree(graph, 2, mode)
+                  .total_weight,
+              tree.total_weight);
+  }
+
+  Graph disconnected;
+  ASSERT_TRUE(
+      disconnected.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  const auto none = GraphAlgorithms::GetMinimumSpanningTree(disconnected);
+  EXPECT_TRUE(none.edges.empty());
+  EXPECT_EQ(none.total_weight, 0);
+}
+
+TEST(AlgorithmsTests, SpanningTreeModesAgree) {
+  const auto total = [](const std::vector<std::vector<long long>>& mst) {
+    long long weight = 0;
+    size_t edges = 0;
+    for (size_t i = 0; i < mst.size(); ++i) {
+      for (size_t j = i + 1; j < mst.size(); ++j) {
+        weight += mst[i][j];
+        edges += mst[i][j] != 0;
+      }
+    }
+    EXPECT_EQ(edges + 1, mst.size());
+    return weight;
+  };
+
+  for (const char* file : {"libraries/tests/data/grid_edge_list.txt",
+                           "libraries/tests/data/edge_list_graph.txt"}) {
+    Graph graph;
+    ASSERT_TRUE(graph.LoadGraphFromEdgeList(file));
+    const long long expected = total(GraphAlgorithms::GetLeastSpanningTree(
+        graph, 1, SpanningTreeMode::kDensePrim));
+    EXPECT_EQ(total(GraphAlgorithms::GetLeastSpanningTree(
+                  graph, 1, SpanningTreeMode::kHeapPrim)),
+              expected);
+    const auto kruskal = GraphAlgorithms::GetLeastSpanningTree(
+        graph, 1, SpanningTreeMode::kKruskal);
+    EXPECT_EQ(total(kruskal), expected);
+    EXPECT_EQ(GraphAlgorithms::GetLeastSpanningTree(
+                  graph, 5, SpanningTreeMode::kKruskal),
+              kruskal);
+    for (unsigned threads : {1u, 4u}) {
+      EXPECT_EQ(total(GraphAlgorithms::GetLeastSpanningTree(
+                    graph, threads, SpanningTreeMode::kBoruvka)),
+                expected);
+    }
+    EXPECT_EQ(total(GraphAlgorithms::GetLeastSpanningTree(graph)), expected);
+  }
+
+  Graph disconnected;
+  ASSERT_TRUE(disconnected.LoadGraphFromEdgeList(
+      "libraries/tests/data/sparse_edge_list.txt"));
+  for (SpanningTreeMode mode :
+       {SpanningTreeMode::kDensePrim, SpanningTreeMode::kHeapPrim,
+        SpanningTreeMode::kKruskal, SpanningTreeMode::kBoruvka}) {
+    EXPECT_TRUE(
+        GraphAlgorithms::GetLeastSpanningTree(disconnected, 2, mode).empty());
+  }
+}
+
+TEST(AlgorithmsTests, ListsOnlySnapshotAlgorithms) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  const std::string path = "libraries/tests/output/algorithms.bin";
+  ASSERT_TRUE(graph.SaveBinary(path, false));
+
+  Graph loaded;
+  ASSERT_TRUE(loaded.LoadBinary(path));
+  EXPECT_EQ(GraphAlgorithms::BreadthFirstSearch(loaded, 2),
+            GraphAlgorithms::BreadthFirstSearch(graph, 2));
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(loaded, 5, 1), 2);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(loaded),
+            GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+  EXPECT_EQ(GraphAlgorithms::GetLeastSpanningTree(loaded),
+            GraphAlgorithms::GetLeastSpanningTree(graph));
+}
+
+TEST(AlgorithmsTests, NarrowWeightsGiveSameResults) {
+  Graph graph;
+  Graph16 narrow;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  ASSERT_TRUE(
+      narrow.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+
+  EXPECT_EQ(GraphAlgorithms16::DepthFirstSearch(narrow, 3),
+            GraphAlgorithms::DepthFirstSearch(graph, 3));
+  EXPECT_EQ(GraphAlgorithms16::GetShortestPathBetweenVertices(narrow, 2, 3), 3);
+  EXPECT_EQ(GraphAlgorithms16::GetShortestPathsBetweenAllVertices(narrow),
+            GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+}
+
+TEST(AlgorithmsTests, WideWeightsKeepOverflowBehaviour) {
+  Graph64 graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/overflow_graph.txt"));
+  EXPECT_EQ(GraphAlgorithms64::GetShortestPathBetweenVertices(graph, 1, 3), -1);
+  EXPECT_EQ(GraphAlgorithms64::GetShortestPathsBetweenAllVertices(graph)[0][2],
+            4294967294LL);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -48,6 +50,93 @@ TEST(GraphLoader, TruncatedFileFails) {
       graph.LoadGraphFromFile("libraries/tests/data/invalid_truncated.txt"));
 }
 
+TEST(GraphLoader, BadSizeFails) {
+  Graph graph;
+  EXPECT_FALSE(
+      graph.LoadGraphFromFile("libraries/tests/data/invalid_bad_size.txt"));
+}
+
+TEST(GraphLoader, ThreadedParseMatchesSequential) {
+  const std::string path = "libraries/tests/output/large_graph.txt";
+  const size_t size = 300;
+  {
+    std::ofstream file(path);
+    file << size << "\n";
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = 0; j < size; ++j) {
+        file << (i == j ? 0 : (i + j) % 97 + 1) << (j + 1 < size ? " " : "\n");
+      }
+    }
+  }
+
+  Graph sequential;
+  Graph threaded;
+  ASSERT_TRUE(sequential.LoadGraphFromFile(path, 1));
+  ASSERT_TRUE(threaded.LoadGraphFromFile(path, 4));
+  ASSERT_EQ(threaded.Size(), size);
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      ASSERT_EQ(threaded.GetAdjecencyMatrix()(i, j),
+                sequential.GetAdjecencyMatrix()(i, j));
+    }
+  }
+  EXPECT_EQ(threaded.GetAdjecencyMatrix()(3, 5), 9);
+}
+
+TEST(GraphLoader, AsymmetryAcrossTilesFails) {
+  const std::string path = "libraries/tests/output/large_asymmetric.txt";
+  /* large enough for validation to be split between threads */
+  const size_t size = 600;
+  {
+    std::ofstream file(path);
+    file << size << "\n";
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = 0; j < size; ++j) {
+        file << (i == 140 && j == 3 ? 2 : (i + j) % 5) << ' ';
+      }
+    }
+  }
+
+  Graph graph;
+  EXPECT_FALSE(graph.LoadGraphFromFile(path, 1));
+  EXPECT_FALSE(graph.LoadGraphFromFile(path, 4));
+}
+
+TEST(GraphLoader, ThreadedParseRejectsTruncatedFile) {
+  const std::string path = "libraries/tests/output/large_truncated.txt";
+  const size_t size = 300;
+  {
+    std::ofstream file(path);
+    file << size << "\n";
+    for (size_t k = 0; k + 1 < size * size; ++k) file << "1 ";
+  }
+
+  Graph graph;
+  EXPECT_FALSE(graph.LoadGraphFromFile(path, 4));
+}
+
+TEST(GraphLoader, MatrixCanBeReleased) {
+  Graph dense;
+  Graph lists;
+  ASSERT_TRUE(
+      dense.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  ASSERT_TRUE(lists.LoadGraphFromFile(
+      "libraries/tests/data/algorithm_graph.txt", 1, false));
+  EXPECT_TRUE(dense.HasAdjacencyMatrix());
+  EXPECT_FALSE(lists.HasAdjacencyMatrix());
+  EXPECT_TRUE(lists.GetAdjecencyMatrix().empty());
+
+  ASSERT_EQ(lists.Size(), dense.Size());
+  for (size_t i = 0; i < dense.Size(); ++i) {
+    EXPECT_TRUE(std::ranges::equal(lists.Neighbors(i), dense.Neighbors(i)));
+    EXPECT_TRUE(std::ranges::equal(lists.NeighborWeights(i),
+                                   dense.NeighborWeights(i)));
+  }
+  /* updates keep working on the lists alone */
+  EXPECT_TRUE(lists.SetWeight(1, 2, 6));
+  EXPECT_EQ(lists.NeighborWeights(0)[0], 6);
+}
+
 TEST(GraphLoader, MatrixIsLoadedCorrectly) {
   Graph graph;
   ASSERT_TRUE(
@@ -59,11 +148,77 @@ TEST(GraphLoader, MatrixIsLoadedCorrectly) {
   EXPECT_EQ(m[1][2], 3);
 }
 
+TEST(GraphLoader, MatrixRowsAreAligned) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+
+  const auto& m = graph.GetAdjecencyMatrix();
+  ASSERT_EQ(m.Rows(), 5u);
+  ASSERT_EQ(m.Cols(), 5u);
+  for (size_t i = 0; i < m.Rows(); ++i) {
+    const auto address = reinterpret_cast<std::uintptr_t>(m.Row(i).data());
+    EXPECT_EQ(address % Matrix<int>::kAlignment, 0u);
+    EXPECT_EQ(m.Row(i).size(), 5u);
+  }
+  EXPECT_EQ(m(4, 2), 4);
+  EXPECT_EQ(m[2][4], 4);
+}
+
+TEST(GraphLoader, AdjacencyListsMatchMatrix) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+
+  EXPECT_EQ(graph.EdgeCount(), 2u);
+  EXPECT_TRUE(graph.Neighbors(0).empty());
+  ASSERT_EQ(graph.Neighbors(1).size(), 1u);
+  EXPECT_EQ(graph.Neighbors(1)[0], 2);
+  EXPECT_EQ(graph.NeighborWeights(1)[0], 5);
+  ASSERT_EQ(graph.Neighbors(2).size(), 1u);
+  EXPECT_EQ(graph.Neighbors(2)[0], 1);
+  EXPECT_TRUE(graph.Neighbors(3).empty());
+}
+
 TEST(GraphLoader, WrongFile) {
   Graph graph;
   ASSERT_FALSE(graph.LoadGraphFromFile("libraries/tests/data/wrong.txt"));
 }
 
+TEST(GraphEdgeList, EdgeListMatchesMatrix) {
+  Graph matrix;
+  ASSERT_TRUE(
+      matrix.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/edge_list_graph.txt"));
+
+  EXPECT_FALSE(graph.HasAdjacencyMatrix());
+  ASSERT_EQ(graph.Size(), matrix.Size());
+  ASSERT_EQ(graph.EdgeCount(), matrix.EdgeCount());
+  for (size_t i = 0; i < graph.Size(); ++i) {
+    EXPECT_TRUE(std::ranges::equal(graph.Neighbors(i), matrix.Neighbors(i)));
+    EXPECT_TRUE(std::ranges::equal(graph.NeighborWeights(i),
+                                   matrix.NeighborWeights(i)));
+  }
+}
+
+TEST(GraphEdgeList, InvalidEdgeListsFail) {
+  Graph graph;
+  EXPECT_FALSE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/invalid_edge_list_duplicate.txt"));
+  EXPECT_FALSE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/invalid_edge_list_non_symmetric.txt"));
+  EXPECT_FALSE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/invalid_edge_list_vertex.txt"));
+  EXPECT_FALSE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/invalid_edge_list_truncated.txt"));
+  EXPECT_FALSE(graph.LoadGraphFromEdgeList(
+      "libraries/tests/data/invalid_bad_size.txt"));
+  EXPECT_FALSE(graph.LoadGraphFromEdgeList("libraries/tests/data/wrong.txt"));
+  EXPECT_EQ(graph.Size(), 0u);
+}
+
 TEST(GraphExport, SimpleGraphExport1) {
   Graph graph;
   ASSERT_TRUE(
@@ -102,6 +257,48 @@ TEST(GraphExport, SimpleGraphExport2) {
   EXPECT_EQ(dot, expected);
 }
 
+TEST(GraphExport, StreamExportMatchesFile) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+
+  const std::string output = "libraries/tests/output/stream.dot";
+  ASSERT_TRUE(graph.ExportGraphToDot(output));
+
+  std::ostringstream stream;
+  ASSERT_TRUE(graph.ExportGraphToDot(stream));
+  EXPECT_EQ(stream.str(), ReadFile(output));
+}
+
+TEST(GraphExport, ThreadedExportMatchesSequential) {
+  const std::string path = "libraries/tests/output/export_graph.txt";
+  const size_t size = 400;
+  {
+    std::ofstream file(path);
+    file << size << "\n";
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = 0; j < size; ++j) {
+        file << (i == j ? 0 : (i * j) % 13) << ' ';
+      }
+    }
+  }
+  Graph graph;
+  ASSERT_TRUE(graph.LoadGraphFromFile(path));
+
+  std::ostringstream sequential;
+  std::ostringstream threaded;
+  ASSERT_TRUE(graph.ExportGraphToDot(sequential, 1));
+  ASSERT_TRUE(graph.ExportGraphToDot(threaded, 4));
+  EXPECT_EQ(threaded.str(), sequential.str());
+  EXPECT_NE(sequential.str().find("  2 -- 7 [label=6]\n"), std::string::npos);
+}
+
+TEST(GraphExport, EmptyGraphFails) {
+  Graph graph;
+  std::ostringstream stream;
+  EXPECT_FALSE(graph.ExportGraphToDot(stream));
+}
+
 TEST(GraphExport, InvalidPathFails) {
   Graph graph;
   ASSERT_TRUE(
@@ -109,3 +306,298 @@ TEST(GraphExport, InvalidPathFails) {
 
   EXPECT_FALSE(graph.ExportGraphToDot("/invalid/path/out.dot"));
 }
+
+TEST(GraphSnapshot, RoundTripKeepsGraph) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  const std::string path = "libraries/tests/output/algorithm_graph.bin";
+  ASSERT_TRUE(graph.SaveBinary(path));
+
+  Graph loaded;
+  ASSERT_TRUE(loaded.LoadBinary(path));
+  ASSERT_EQ(loaded.Size(), graph.Size());
+  ASSERT_EQ(loaded.EdgeCount(), graph.EdgeCount());
+  ASSERT_TRUE(loaded.HasAdjacencyMatrix());
+  EXPECT_TRUE(loaded.GetAdjecencyMatrix().Storage().IsBorrowed());
+  for (size_t i = 0; i < graph.Size(); ++i) {
+    for (size_t j = 0; j < graph.Size(); ++j) {
+      EXPECT_EQ(loaded.GetAdjecencyMatrix()(i, j),
+                graph.GetAdjecencyMatrix()(i, j));
+    }
+    EXPECT_TRUE(std::ranges::equal(loaded.Neighbors(i), graph.Neighbors(i)));
+    EXPECT_TRUE(std::ranges::equal(loaded.NeighborWeights(i),
+                                   graph.NeighborWeights(i)));
+  }
+}
+
+TEST(GraphSnapshot, ListsOnlySnapshotExports) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_1.txt"));
+  const std::string path = "libraries/tests/output/valid_graph_1.bin";
+  ASSERT_TRUE(graph.SaveBinary(path, false));
+
+  Graph loaded;
+  ASSERT_TRUE(loaded.LoadBinary(path));
+  EXPECT_FALSE(loaded.HasAdjacencyMatrix());
+  ASSERT_EQ(loaded.Size(), 3u);
+
+  const std::string output = "libraries/tests/output/snapshot1.dot";
+  ASSERT_TRUE(loaded.ExportGraphToDot(output));
+  EXPECT_EQ(ReadFile(output),
+            "graph G {\n"
+            "  1 -- 2 [label=1]\n"
+            "  1 -- 3 [label=2]\n"
+            "  2 -- 3 [label=3]\n"
+            "}\n");
+}
+
+TEST(GraphSnapshot, CorruptedSnapshotFails) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_1.txt"));
+  const std::string path = "libraries/tests/output/corrupted.bin";
+  ASSERT_TRUE(graph.SaveBinary(path));
+
+  std::string bytes = ReadFile(path);
+  bytes[bytes.size() - 1] ^= 0x7f;
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+
+  Graph loaded;
+  EXPECT_FALSE(loaded.LoadBinary(path));
+  EXPECT_EQ(loaded.Size(), 0u);
+}
+
+TEST(GraphSnapshot, MalformedListsFailWithoutChecksum) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  const std::string path = "libraries/tests/output/malformed.bin";
+  ASSERT_TRUE(graph.SaveBinary(path));
+  const std::string with_matrix = ReadFile(path);
+  ASSERT_TRUE(graph.SaveBinary(path, false));
+  const std::string lists_only = ReadFile(path);
+
+  /* header fields: entries at byte 32, offsets_at 48, neighbors_at 56,
+   * weights_at 64, matrix_at 72 */
+  const auto field = [](const std::string& bytes, size_t at) {
+    uint64_t value = 0;
+    std::memcpy(&value, bytes.data() + at, sizeof(value));
+    return value;
+  };
+  const auto patch = [](std::string& bytes, uint64_t at, const auto& value) {
+    std::memcpy(bytes.data() + at, &value, sizeof(value));
+  };
+  const auto load = [&path](const std::string& bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    Graph loaded;
+    return loaded.LoadBinary(path, false);
+  };
+  const uint64_t offsets = field(lists_only, 48);
+  const uint64_t neighbors = field(lists_only, 56);
+  const uint64_t weights = field(lists_only, 64);
+  const auto patched = [&](uint64_t at, const auto& value) {
+    std::string bytes = lists_only;
+    patch(bytes, at, value);
+    return bytes;
+  };
+
+  EXPECT_TRUE(load(lists_only));
+  EXPECT_TRUE(load(with_matrix));
+  /* the last row starting past the entries, the rows before it are valid */
+  EXPECT_FALSE(load(patched(offsets + 4 * sizeof(size_t), size_t{1000})));
+  /* a neighbor out of range, rows out of order, a zero weight */
+  EXPECT_FALSE(load(patched(neighbors, int{11})));
+  EXPECT_FALSE(load(patched(neighbors + sizeof(int), int{0})));
+  EXPECT_FALSE(load(patched(weights, int{0})));
+  /* 1 -> 2 weighs 5, 2 -> 1 still weighs 1 */
+  EXPECT_FALSE(load(patched(weights, int{5})));
+
+  /* no edges at all */
+  std::string edgeless = lists_only;
+  patch(edgeless, 32, uint64_t{0});
+  for (size_t v = 1; v <= graph.Size(); ++v) {
+    patch(edgeless, offsets + v * sizeof(size_t), size_t{0});
+  }
+  EXPECT_FALSE(load(edgeless));
+
+  /* a dense section disagreeing with valid lists */
+  std::string matrix = with_matrix;
+  patch(matrix, field(with_matrix, 72) + sizeof(int), int{7});
+  EXPECT_FALSE(load(matrix));
+}
+
+TEST(GraphSnapshot, TextFileIsNotSnapshot) {
+  Graph graph;
+  EXPECT_FALSE(graph.LoadBinary("libraries/tests/data/valid_graph_1.txt"));
+  EXPECT_FALSE(graph.LoadBinary("libraries/tests/data/wrong.bin"));
+  EXPECT_FALSE(graph.SaveBinary("libraries/tests/output/empty.bin"));
+}
+
+TEST(GraphWeights, NarrowGraphMatchesIntGraph) {
+  Graph graph;
+  Graph8 narrow;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  ASSERT_TRUE(
+      narrow.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+
+  static_assert(sizeof(Graph8::WeightType) == 1);
+  static_assert(std::is_same_v<Graph8::Distance, int32_t>);
+  ASSERT_EQ(narrow.Size(), graph.Size());
+  for (size_t i = 0; i < graph.Size(); ++i) {
+    EXPECT_TRUE(std::ranges::equal(narrow.Neighbors(i), graph.Neighbors(i)));
+    EXPECT_TRUE(std::ranges::equal(narrow.NeighborWeights(i),
+                                   graph.NeighborWeights(i)));
+  }
+}
+
+TEST(GraphWeights, WeightOutOfRangeFails) {
+  Graph8 narrow;
+  Graph16 medium;
+  Graph64 wide;
+  EXPECT_FALSE(
+      narrow.LoadGraphFromFile("libraries/tests/data/overflow_graph.txt"));
+  EXPECT_FALSE(
+      medium.LoadGraphFromFile("libraries/tests/data/overflow_graph.txt"));
+  EXPECT_TRUE(
+      wide.LoadGraphFromFile("libraries/tests/data/overflow_graph.txt"));
+  EXPECT_FALSE(medium.LoadGraphFromFile(
+      "libraries/tests/data/invalid_negative_weight.txt"));
+}
+
+TEST(GraphWeights, SnapshotWeightTypeMustMatch) {
+  Graph16 graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_1.txt"));
+  const std::string path = "libraries/tests/output/weights16.bin";
+  ASSERT_TRUE(graph.SaveBinary(path));
+
+  Graph other;
+  EXPECT_FALSE(other.LoadBinary(path));
+  Graph16 same;
+  EXPECT_TRUE(same.LoadBinary(path));
+  EXPECT_EQ(same.NeighborWeights(1)[1], 3);
+}
+
+TEST(GraphMutation, AddSetRemoveKeepSymmetry) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  const uint64_t loaded = graph.Version();
+
+  EXPECT_TRUE(graph.AddEdge(1, 4, 7));
+  EXPECT_FALSE(graph.AddEdge(4, 1, 7));
+  EXPECT_EQ(graph.Version(), loaded + 1);
+  EXPECT_EQ(graph.EdgeCount(), 4u);
+  EXPECT_EQ(graph.GetAdjecencyMatrix()(0, 3), 7);
+  EXPECT_EQ(graph.GetAdjecencyMatrix()(3, 0), 7);
+  ASSERT_EQ(graph.Neighbors(3).size(), 1u);
+  EXPECT_EQ(graph.Neighbors(3)[0], 0);
+
+  EXPECT_TRUE(graph.SetWeight(4, 1, 9));
+  EXPECT_EQ(graph.NeighborWeights(0)[0], 9);
+  EXPECT_EQ(graph.NeighborWeights(3)[0], 9);
+  EXPECT_EQ(graph.GetAdjecencyMatrix()(3, 0), 9);
+
+  EXPECT_TRUE(graph.RemoveEdge(2, 3));
+  EXPECT_TRUE(graph.Neighbors(1).empty());
+  EXPECT_EQ(graph.GetAdjecencyMatrix()(1, 2), 0);
+  EXPECT_EQ(graph.EdgeCount(), 2u);
+  EXPECT_EQ(graph.Version(), loaded + 3);
+}
+
+TEST(GraphMutation, VersionsDifferBetweenGraphs) {
+  Graph a;
+  Graph b;
+  ASSERT_TRUE(a.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  ASSERT_TRUE(b.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  EXPECT_NE(a.Version(), b.Version());
+
+  /* a copy is the same state until either side changes */
+  Graph c = a;
+  EXPECT_EQ(c.Version(), a.Version());
+  EXPECT_TRUE(a.AddEdge(1, 4, 1));
+  EXPECT_TRUE(c.AddEdge(1, 3, 1));
+  EXPECT_NE(c.Version(), a.Version());
+  EXPECT_NE(c.Version(), b.Version());
+}
+
+TEST(GraphMutation, InvalidUpdatesFail) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  const uint64_t loaded = graph.Version();
+
+  EXPECT_FALSE(graph.AddEdge(0, 1, 1));
+  EXPECT_FALSE(graph.AddEdge(1, 5, 1));
+  EXPECT_FALSE(graph.AddEdge(1, 2, 0));
+  EXPECT_FALSE(graph.AddEdge(1, 2, -3));
+  EXPECT_FALSE(graph.SetWeight(1, 2, 4));
+  EXPECT_FALSE(graph.SetWeight(2, 3, 0));
+  EXPECT_FALSE(graph.RemoveEdge(1, 2));
+  /* the only edge of the graph stays */
+  EXPECT_FALSE(graph.RemoveEdge(3, 2));
+  EXPECT_EQ(graph.Version(), loaded);
+
+  Graph empty;
+  EXPECT_FALSE(empty.AddEdge(1, 1, 1));
+}
+
+TEST(GraphMutation, ManyUpdatesMatchModel) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/edge_list_graph.txt"));
+
+  const int size = static_cast<int>(graph.Size());
+  std::vector<std::vector<int>> model(size, std::vector<int>(size, 0));
+  for (int i = 0; i < size; ++i) {
+    const auto ids = graph.Neighbors(i);
+    for (size_t e = 0; e < ids.size(); ++e) {
+      model[i][ids[e]] = graph.NeighborWeights(i)[e];
+    }
+  }
+
+  unsigned seed = 7;
+  for (int step = 0; step < 2000; ++step) {
+    seed = seed * 1103515245u + 12345u;
+    const int u = static_cast<int>(seed >> 8) % size;
+    const int v = static_cast<int>(seed >> 16) % size;
+    const int weight = static_cast<int>(seed >> 24) % 9 + 1;
+    if (model[u][v] == 0) {
+      ASSERT_TRUE(graph.AddEdge(u + 1, v + 1, weight));
+      model[u][v] = model[v][u] = weight;
+    } else if (step % 3 == 0) {
+      ASSERT_TRUE(graph.SetWeight(u + 1, v + 1, weight));
+      model[u][v] = model[v][u] = weight;
+    } else if (graph.RemoveEdge(u + 1, v + 1)) {
+      model[u][v] = model[v][u] = 0;
+    }
+  }
+
+  size_t entries = 0;
+  for (int i = 0; i < size; ++i) {
+    std::vector<int> ids;
+    std::vector<int> weights;
+    for (int j = 0; j < size; ++j) {
+      if (model[i][j] != 0) {
+        ids.push_back(j);
+        weights.push_back(model[i][j]);
+      }
+    }
+    EXPECT_TRUE(std::ranges::equal(graph.Neighbors(i), ids));
+    EXPECT_TRUE(std::ranges::equal(graph.NeighborWeights(i), weights));
+    entries += ids.size();
+  }
+  EXPECT_EQ(graph.EdgeCount(), entries);
+
+  const std::string path = "libraries/tests/output/mutated.bin";
+  ASSERT_TRUE(graph.SaveBinary(path));
+  Graph loaded;
+  ASSERT_TRUE(loaded.LoadBinary(path));
+  ASSERT_EQ(loaded.EdgeCount(), entries);
+  for (int i = 0; i < size; ++i) {
+    EXPECT_TRUE(std::ranges::equal(loaded.Neighbors(i), graph.Neighbors(i)));
+  }
+}
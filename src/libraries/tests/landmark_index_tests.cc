@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "graph.h"
+#include "graph_algorithms.h"
+#include "landmark_index.h"
+
+TEST(LandmarkIndex, BuildFail) {
+  Graph graph;
+  LandmarkIndex index;
+  EXPECT_FALSE(index.Build(graph, 4));
+  EXPECT_FALSE(index.IsBuiltFor(graph));
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  EXPECT_FALSE(index.Build(graph, 0));
+  EXPECT_EQ(index.GetShortestPathBetweenVertices(graph, 0, 2), -1);
+  EXPECT_EQ(index.GetShortestPathBetweenVertices(graph, 1, 6), -1);
+}
+
+TEST(LandmarkIndex, FarthestPointSelection) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  LandmarkIndex index;
+  ASSERT_TRUE(index.Build(graph, 4));
+  ASSERT_TRUE(index.IsBuiltFor(graph));
+
+  auto landmarks = index.Landmarks();
+  ASSERT_EQ(landmarks.size(), 4u);
+  std::sort(landmarks.begin(), landmarks.end());
+  EXPECT_EQ(std::unique(landmarks.begin(), landmarks.end()),
+            landmarks.end());
+
+  /* more landmarks than vertices makes every vertex one */
+  Graph small;
+  ASSERT_TRUE(
+      small.LoadGraphFromFile("libraries/tests/data/algorithm_graph.txt"));
+  ASSERT_TRUE(index.Build(small, 16));
+  EXPECT_EQ(index.Landmarks().size(), small.Size());
+}
+
+TEST(LandmarkIndex, MatchesDijkstraOnGrid) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  LandmarkIndex index;
+  ASSERT_TRUE(index.Build(graph, 8));
+
+  const int size = static_cast<int>(graph.Size());
+  for (int from = 1; from <= size; from += 41) {
+    const auto tree = GraphAlgorithms::GetShortestPathTree(graph, from);
+    for (int to = 1; to <= size; to += 13) {
+      EXPECT_EQ(index.GetShortestPathBetweenVertices(graph, from, to),
+                tree.distance[to - 1]);
+    }
+  }
+}
+
+TEST(LandmarkIndex, Disconnected) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromFile("libraries/tests/data/valid_graph_2.txt"));
+  LandmarkIndex index;
+  ASSERT_TRUE(index.Build(graph, 2));
+  EXPECT_EQ(index.GetShortestPathBetweenVertices(graph, 1, 3), -1);
+  EXPECT_EQ(index.GetShortestPathBetweenVertices(graph, 3, 2), 5);
+  EXPECT_EQ(index.GetShortestPathBetweenVertices(graph, 4, 4), 0);
+}
+
+TEST(LandmarkIndex, StaleIndexFallsBack) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  LandmarkIndex index;
+  ASSERT_TRUE(index.Build(graph, 4));
+
+  /* a shortcut across the grid breaks the stored lower bounds */
+  ASSERT_TRUE(graph.AddEdge(1, 900, 1));
+  EXPECT_FALSE(index.IsBuiltFor(graph));
+  EXPECT_EQ(index.GetShortestPathBetweenVertices(graph, 1, 900), 1);
+  EXPECT_EQ(index.GetShortestPathBetweenVertices(graph, 2, 899),
+            GraphAlgorithms::GetShortestPathBetweenVertices(graph, 2, 899));
+}
+
+TEST(LandmarkIndex, OtherGraphOfSameSizeFallsBack) {
+  Graph a;
+  ASSERT_TRUE(
+      a.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  Graph b = a;
+  Graph c = a;
+  ASSERT_TRUE(b.AddEdge(1, 900, 1));
+  ASSERT_TRUE(c.AddEdge(2, 899, 1));
+
+  LandmarkIndex index;
+  ASSERT_TRUE(index.Build(c, 8));
+  EXPECT_TRUE(index.IsBuiltFor(c));
+  EXPECT_FALSE(index.IsBuiltFor(a));
+  EXPECT_FALSE(index.IsBuiltFor(b));
+
+  /* bounds from c would be wrong for b's shortcut */
+  const int size = static_cast<int>(b.Size());
+  for (int from = 1; from <= size; from += 47) {
+    const auto tree = GraphAlgorithms::GetShortestPathTree(b, from);
+    for (int to = 1; to <= size; to += 11) {
+      EXPECT_EQ(index.GetShortestPathBetweenVertices(b, from, to),
+                tree.distance[to - 1]);
+    }
+  }
+}
+
+TEST(LandmarkIndex, ConcurrentQueries) {
+  Graph graph;
+  ASSERT_TRUE(
+      graph.LoadGraphFromEdgeList("libraries/tests/data/grid_edge_list.txt"));
+  LandmarkIndex index;
+  ASSERT_TRUE(index.Build(graph, 8));
+  const auto tree = GraphAlgorithms::GetShortestPathTree(graph, 1);
+
+  /* a const index is shared, every thread searches with its own workspace */
+  const LandmarkIndex& shared = index;
+  const int size = static_cast<int>(graph.Size());
+  std::vector<int> mismatches(4, 0);
+  ParallelFor(4, 4, [&](unsigned worker, size_t, size_t) {
+    LandmarkIndex::Workspace workspace;
+    for (int round = 0; round < 3; ++round) {
+      for (int to = 1 + static_cast<int>(worker); to <= size; to += 7) {
+        const int expected = tree.distance[to - 1];
+        if (shared.GetShortestPathBetweenVertices(graph, 1, to) != expected ||
+            shared.GetShortestPathBetweenVertices(graph, 1, to, workspace) !=
+                expected) {
+          ++mismatches[worker];
+        }
+      }
+    }
+  });
+  EXPECT_EQ(mismatches, std::vector<int>(4, 0));
+}
@@ -1,6 +1,8 @@
 #ifndef S21_VECTOR_H
 #define S21_VECTOR_H
 
+#include <utility>
+
 namespace s21 {
 
 template <typename T>